@@ -0,0 +1,381 @@
+/*
+* MIT License
+*
+* Copyright (c) 2025 Meysam Zare
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*/
+
+
+#ifndef IO_BASE64_STREAM_HEADER_FILE
+#define IO_BASE64_STREAM_HEADER_FILE
+#pragma once
+
+/**
+ * @file Base64Stream.h
+ * @brief Incremental Base64 encoding and decoding, and file-to-file conversion
+ *
+ * Base64StreamEncoder and Base64StreamDecoder accept input in chunks of any
+ * size and split at any byte, carrying the incomplete 3-byte or 4-character
+ * group to the next call; the concatenated output equals what Base64 produces
+ * for the whole input at once. All bulk work goes through the SIMD paths of
+ * Base64, so chunked conversion runs at the same speed as one-shot conversion.
+ *
+ * base64EncodeFile / base64DecodeFile convert files of any size through two
+ * fixed buffers of about Base64StreamChunkBytes, never holding the file in
+ * memory.
+ *
+ * @author Meysam Zare
+ * @date October 18, 2026
+ */
+
+#include <cstdint>
+#include <cstddef>
+#include <algorithm>
+#include <filesystem>
+#include <memory>
+#include <new>
+#include <optional>
+#include <span>
+#include <string_view>
+
+#include "Encode64.h"
+#include "FileIO.h"
+
+namespace mz {
+
+    /**
+     * @brief Input bytes per step of file encoding (a multiple of 3; the output step is 4/3 of it)
+     */
+    inline constexpr size_t Base64StreamChunkBytes{ size_t{ 3 } << 22 };
+
+    /**
+     * @class Base64StreamEncoder
+     * @brief Base64 encoder fed in chunks
+     */
+    class Base64StreamEncoder {
+    public:
+        /**
+         * @brief Constructor
+         *
+         * @param alphabet Output alphabet
+         * @param padding Whether finish() pads the last group with '='
+         */
+        explicit Base64StreamEncoder(Base64Alphabet alphabet = Base64Alphabet::Standard, bool padding = true) noexcept
+            : m_alphabet{ alphabet }, m_padding{ padding } {}
+
+        /**
+         * @brief Output capacity that update() needs for a chunk of `bytes` bytes
+         */
+        static constexpr size_t maxOutput(size_t bytes) noexcept { return (bytes + 2) / 3 * 4; }
+
+        /**
+         * @brief Output capacity that finish() needs
+         */
+        static constexpr size_t FinishOutput{ 4 };
+
+        /**
+         * @brief Encode a chunk
+         *
+         * Up to two trailing bytes are held back until more input or finish().
+         *
+         * @param chunk Input bytes
+         * @param out Destination of at least maxOutput(chunk.size()) characters
+         * @return Characters written, or std::nullopt if `out` is too small (nothing is consumed)
+         */
+        std::optional<size_t> update(std::span<const uint8_t> chunk, std::span<char> out) noexcept {
+            if (out.size() < maxOutput(chunk.size())) return std::nullopt;
+            size_t written = 0;
+            if (m_count) {
+                while (m_count < 3 && !chunk.empty()) {
+                    m_pending[m_count++] = chunk.front();
+                    chunk = chunk.subspan(1);
+                }
+                if (m_count < 3) return 0;
+                written = *Base64::encode(std::span<const uint8_t>(m_pending, 3), out, m_alphabet, false);
+                m_count = 0;
+            }
+            const size_t whole = chunk.size() / 3 * 3;
+            written += *Base64::encode(chunk.first(whole), out.subspan(written), m_alphabet, false);
+            for (size_t i = whole; i < chunk.size(); ++i) m_pending[m_count++] = chunk[i];
+            return written;
+        }
+
+        /**
+         * @brief Encode the held-back bytes and reset for a new stream
+         *
+         * @param out Destination of at least FinishOutput characters
+         * @return Characters written, or std::nullopt if `out` is too small
+         */
+        std::optional<size_t> finish(std::span<char> out) noexcept {
+            if (out.size() < FinishOutput) return std::nullopt;
+            const auto written = Base64::encode(std::span<const uint8_t>(m_pending, m_count), out, m_alphabet, m_padding);
+            m_count = 0;
+            return written;
+        }
+
+        /**
+         * @brief Discard held-back bytes
+         */
+        void reset() noexcept { m_count = 0; }
+
+    private:
+        Base64Alphabet m_alphabet;
+        bool m_padding;
+        uint8_t m_count{ 0 };           ///< Bytes held in m_pending, 0 to 2
+        uint8_t m_pending[3]{};
+    };
+
+    /**
+     * @class Base64StreamDecoder
+     * @brief Validating Base64 decoder fed in chunks
+     *
+     * Validation matches Base64::decode on the concatenated input: padding is
+     * optional, and once a padded group has been decoded any further input is
+     * an error. After an error every call fails until reset().
+     */
+    class Base64StreamDecoder {
+    public:
+        /**
+         * @brief Constructor
+         * @param alphabet Input alphabet
+         */
+        explicit Base64StreamDecoder(Base64Alphabet alphabet = Base64Alphabet::Standard) noexcept
+            : m_alphabet{ alphabet } {}
+
+        /**
+         * @brief Output capacity that update() needs for a chunk of `chars` characters
+         */
+        static constexpr size_t maxOutput(size_t chars) noexcept { return (chars + 3) / 4 * 3; }
+
+        /**
+         * @brief Output capacity that finish() needs
+         */
+        static constexpr size_t FinishOutput{ 2 };
+
+        /**
+         * @brief Decode a chunk
+         *
+         * Up to three trailing characters are held back until more input or finish().
+         *
+         * @param chunk Input characters
+         * @param out Destination of at least maxOutput(chunk.size()) bytes
+         * @return Bytes written, or std::nullopt if the input is invalid or
+         *         `out` is too small (in which case nothing is consumed)
+         */
+        std::optional<size_t> update(std::string_view chunk, std::span<uint8_t> out) noexcept {
+            if (m_failed || out.size() < maxOutput(chunk.size())) return std::nullopt;
+            if (chunk.empty()) return 0;
+            if (m_done) return fail();
+
+            size_t written = 0;
+            if (m_count) {
+                while (m_count < 4 && !chunk.empty()) {
+                    m_pending[m_count++] = chunk.front();
+                    chunk.remove_prefix(1);
+                }
+                if (m_count < 4) return 0;
+                const auto n = Base64::decode(std::string_view(m_pending, 4), out, m_alphabet);
+                if (!n) return fail();
+                written = *n;
+                m_done = m_pending[3] == '=';
+                m_count = 0;
+            }
+            const size_t whole = chunk.size() / 4 * 4;
+            if (whole) {
+                if (m_done) return fail();
+                const auto n = Base64::decode(chunk.substr(0, whole), out.subspan(written), m_alphabet);
+                if (!n) return fail();
+                written += *n;
+                m_done = chunk[whole - 1] == '=';
+            }
+            if (whole < chunk.size()) {
+                if (m_done) return fail();
+                for (size_t i = whole; i < chunk.size(); ++i) m_pending[m_count++] = chunk[i];
+            }
+            return written;
+        }
+
+        /**
+         * @brief Decode the held-back characters (an unpadded last group) and reset
+         *
+         * @param out Destination of at least FinishOutput bytes
+         * @return Bytes written, or std::nullopt if the input was invalid or ended mid-group
+         */
+        std::optional<size_t> finish(std::span<uint8_t> out) noexcept {
+            if (m_failed || out.size() < FinishOutput) return std::nullopt;
+            const auto n = Base64::decode(std::string_view(m_pending, m_count), out, m_alphabet);
+            reset();
+            return n;
+        }
+
+        /**
+         * @brief Clear the error state and held-back characters for a new stream
+         */
+        void reset() noexcept {
+            m_count = 0;
+            m_done = false;
+            m_failed = false;
+        }
+
+    private:
+        Base64Alphabet m_alphabet;
+        bool m_done{ false };           ///< A padded group has ended the stream
+        bool m_failed{ false };
+        uint8_t m_count{ 0 };           ///< Characters held in m_pending, 0 to 3
+        char m_pending[4]{};
+
+        std::optional<size_t> fail() noexcept {
+            m_failed = true;
+            return std::nullopt;
+        }
+    };
+
+    namespace detail {
+
+        /**
+         * @brief Stream the rest of `in` through `convert` into `out`
+         *
+         * convert(chunk, dst) -> std::optional<size_t> converts one chunk;
+         * finish(dst) -> std::optional<size_t> flushes the converter.
+         */
+        template <typename Convert, typename Finish>
+        bool base64Pipe(io::FileRO& in, io::FileWO& out, size_t inStep, size_t outStep,
+            Convert&& convert, Finish&& finish) noexcept {
+            if (!in.is_open() || !out.is_open()) return true;
+            const int64_t size = in.size();
+            const int64_t start = in.tell();
+            if (size < 0 || start < 0) return true;
+
+            std::unique_ptr<uint8_t[]> src{ new (std::nothrow) uint8_t[inStep] };
+            std::unique_ptr<uint8_t[]> dst{ new (std::nothrow) uint8_t[outStep] };
+            if (!src || !dst) return true;
+
+            for (uint64_t remaining = static_cast<uint64_t>(std::max<int64_t>(size - start, 0)); remaining;) {
+                const size_t step = static_cast<size_t>(std::min<uint64_t>(inStep, remaining));
+                if (in.read(src.get(), step)) return true;
+                remaining -= step;
+                const auto n = convert(src.get(), step, dst.get());
+                if (!n || (*n && out.write(dst.get(), *n))) return true;
+            }
+            const auto n = finish(dst.get());
+            return !n || (*n && out.write(dst.get(), *n));
+        }
+
+        inline int base64OutputFlags() noexcept {
+            int flags = O_TRUNC;
+#ifdef _MSC_VER
+            flags |= _O_BINARY;
+#endif
+            return flags;
+        }
+
+        inline int base64InputFlags() noexcept {
+#ifdef _MSC_VER
+            return _O_BINARY | _O_SEQUENTIAL;
+#else
+            return 0;
+#endif
+        }
+
+    } // namespace detail
+
+    /**
+     * @brief Base64-encode the rest of a file into another
+     *
+     * @param in File opened for reading; encoding starts at its current position
+     * @param out File opened for writing
+     * @param alphabet Output alphabet
+     * @param padding Whether to pad the last group with '='
+     * @return true if an error occurred, false on success
+     */
+    inline bool base64EncodeFile(io::FileRO& in, io::FileWO& out,
+        Base64Alphabet alphabet = Base64Alphabet::Standard, bool padding = true) noexcept {
+        Base64StreamEncoder encoder{ alphabet, padding };
+        return detail::base64Pipe(in, out, Base64StreamChunkBytes, Base64StreamEncoder::maxOutput(Base64StreamChunkBytes),
+            [&](uint8_t const* src, size_t n, uint8_t* dst) noexcept {
+                return encoder.update(std::span<const uint8_t>(src, n),
+                    std::span<char>(reinterpret_cast<char*>(dst), Base64StreamEncoder::maxOutput(n)));
+            },
+            [&](uint8_t* dst) noexcept {
+                return encoder.finish(std::span<char>(reinterpret_cast<char*>(dst), Base64StreamEncoder::FinishOutput));
+            });
+    }
+
+    /**
+     * @brief Decode the rest of a Base64 file into another
+     *
+     * The text must be a single Base64 string without line breaks or other
+     * whitespace. On error `out` holds an unspecified prefix of the result.
+     *
+     * @param in File opened for reading; decoding starts at its current position
+     * @param out File opened for writing
+     * @param alphabet Input alphabet
+     * @return true if an error occurred (including invalid Base64), false on success
+     */
+    inline bool base64DecodeFile(io::FileRO& in, io::FileWO& out,
+        Base64Alphabet alphabet = Base64Alphabet::Standard) noexcept {
+        constexpr size_t chars = Base64StreamChunkBytes / 3 * 4;
+        Base64StreamDecoder decoder{ alphabet };
+        return detail::base64Pipe(in, out, chars, Base64StreamDecoder::maxOutput(chars),
+            [&](uint8_t const* src, size_t n, uint8_t* dst) noexcept {
+                return decoder.update(std::string_view(reinterpret_cast<char const*>(src), n),
+                    std::span<uint8_t>(dst, Base64StreamDecoder::maxOutput(n)));
+            },
+            [&](uint8_t* dst) noexcept {
+                return decoder.finish(std::span<uint8_t>(dst, Base64StreamDecoder::FinishOutput));
+            });
+    }
+
+    /**
+     * @brief Base64-encode a file into a new (or truncated) file
+     *
+     * @param from Source path
+     * @param to Destination path
+     * @param alphabet Output alphabet
+     * @param padding Whether to pad the last group with '='
+     * @return true if an error occurred, false on success
+     */
+    inline bool base64EncodeFile(std::filesystem::path const& from, std::filesystem::path const& to,
+        Base64Alphabet alphabet = Base64Alphabet::Standard, bool padding = true) noexcept {
+        io::FileRO in;
+        io::FileWO out;
+        if (!in.open(from, detail::base64InputFlags()) || !out.create(to, detail::base64OutputFlags())) return true;
+        return base64EncodeFile(in, out, alphabet, padding);
+    }
+
+    /**
+     * @brief Decode a Base64 file into a new (or truncated) file
+     *
+     * @param from Source path
+     * @param to Destination path
+     * @param alphabet Input alphabet
+     * @return true if an error occurred (including invalid Base64), false on success
+     */
+    inline bool base64DecodeFile(std::filesystem::path const& from, std::filesystem::path const& to,
+        Base64Alphabet alphabet = Base64Alphabet::Standard) noexcept {
+        io::FileRO in;
+        io::FileWO out;
+        if (!in.open(from, detail::base64InputFlags()) || !out.create(to, detail::base64OutputFlags())) return true;
+        return base64DecodeFile(in, out, alphabet);
+    }
+
+} // namespace mz
+
+#endif // IO_BASE64_STREAM_HEADER_FILE
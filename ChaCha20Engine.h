@@ -0,0 +1,395 @@
+/*
+MIT License
+
+Copyright (c) 2021-2024 Meysam Zare
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef MZ_CHACHA20_ENGINE_HEADER_FILE
+#define MZ_CHACHA20_ENGINE_HEADER_FILE
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+#include <algorithm>
+#include <array>
+#include <exception>
+#include <limits>
+#include <random>
+#include <span>
+
+#include "Randomizer.h"
+
+#if defined(_WIN32)
+#include <windows.h>
+#include <bcrypt.h>
+#pragma comment(lib, "bcrypt")
+#elif defined(__linux__)
+#include <sys/random.h>
+#include <cerrno>
+#else
+#include <unistd.h>
+#endif
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define MZ_CHACHA20_SSE2 1
+#endif
+
+/**
+ * @file ChaCha20Engine.h
+ * @brief Cryptographically secure random engine on the ChaCha20 keystream
+ *
+ * ChaCha20Engine generates the ChaCha20 keystream (RFC 8439 block function,
+ * 64-bit block counter) into a 4 KiB buffer and hands it out 64 bits at a
+ * time, so the operating system is only asked for a key once per engine.
+ *
+ * Fast key erasure (Bernstein, 2017): every refill takes the first 32 bytes of
+ * the new keystream as the next key, and every byte is zeroed in the buffer as
+ * it is handed out. A copy of the engine's memory taken later cannot recover
+ * output that was already produced.
+ *
+ * The engine never generates without a key from a real entropy source or an
+ * explicit seed(): if neither the operating system nor std::random_device can
+ * supply a key it terminates the program, and a moved-from engine rekeys from
+ * the operating system before its next output.
+ *
+ * The block function computes four blocks at once with SSE2 where available
+ * and falls back to a scalar implementation.
+ *
+ * @author Meysam Zare
+ * @date 2026-10-18
+ */
+
+namespace mz {
+    namespace detail {
+
+        /**
+         * @brief Overwrite memory in a way the compiler cannot elide
+         */
+        inline void secureZero(void* data, size_t size) noexcept {
+            volatile unsigned char* p = static_cast<volatile unsigned char*>(data);
+            while (size--) *p++ = 0;
+        }
+
+        /**
+         * @brief Fill a buffer from the operating system CSPRNG
+         *
+         * getrandom on Linux, BCryptGenRandom on Windows, getentropy elsewhere.
+         *
+         * @return true on success
+         */
+        inline bool osRandom(void* data, size_t size) noexcept {
+            auto* p = static_cast<unsigned char*>(data);
+#if defined(_WIN32)
+            return BCRYPT_SUCCESS(BCryptGenRandom(nullptr, p, static_cast<ULONG>(size), BCRYPT_USE_SYSTEM_PREFERRED_RNG));
+#elif defined(__linux__)
+            while (size) {
+                ssize_t n = ::getrandom(p, size, 0);
+                if (n < 0) {
+                    if (errno == EINTR) continue;
+                    return false;
+                }
+                p += n;
+                size -= static_cast<size_t>(n);
+            }
+            return true;
+#else
+            while (size) {
+                size_t chunk = std::min<size_t>(size, 256);   // getentropy limit
+                if (::getentropy(p, chunk) != 0) return false;
+                p += chunk;
+                size -= chunk;
+            }
+            return true;
+#endif
+        }
+
+        constexpr uint32_t rotl32(uint32_t x, int k) noexcept { return (x << k) | (x >> (32 - k)); }
+
+        inline uint32_t load32le(unsigned char const* p) noexcept {
+            return uint32_t{ p[0] } | (uint32_t{ p[1] } << 8) | (uint32_t{ p[2] } << 16) | (uint32_t{ p[3] } << 24);
+        }
+
+        inline void store32le(unsigned char* p, uint32_t v) noexcept {
+            p[0] = static_cast<unsigned char>(v);
+            p[1] = static_cast<unsigned char>(v >> 8);
+            p[2] = static_cast<unsigned char>(v >> 16);
+            p[3] = static_cast<unsigned char>(v >> 24);
+        }
+
+        /**
+         * @brief ChaCha20 keystream blocks
+         *
+         * State layout: constants, 8 key words, 64-bit block counter (words 12-13),
+         * 64-bit nonce (words 14-15).
+         *
+         * @param key 32-byte key
+         * @param counter Counter of the first block
+         * @param nonce Nonce
+         * @param out Destination, 64 bytes per block
+         * @param blocks Number of blocks
+         */
+        inline void chacha20Blocks(unsigned char const* key, uint64_t counter, uint64_t nonce,
+            unsigned char* out, size_t blocks) noexcept {
+            uint32_t in[16]{ 0x61707865, 0x3320646E, 0x79622D32, 0x6B206574 };
+            for (int i = 0; i < 8; ++i) in[4 + i] = load32le(key + 4 * i);
+            in[14] = static_cast<uint32_t>(nonce);
+            in[15] = static_cast<uint32_t>(nonce >> 32);
+
+#if defined(MZ_CHACHA20_SSE2)
+            auto rotl = [](__m128i x, int k) noexcept {
+                return _mm_or_si128(_mm_slli_epi32(x, k), _mm_srli_epi32(x, 32 - k));
+            };
+            for (; blocks >= 4; blocks -= 4, counter += 4, out += 256) {
+                __m128i orig[16], x[16];
+                for (int i = 0; i < 16; ++i) orig[i] = _mm_set1_epi32(static_cast<int>(in[i]));
+                uint64_t c0 = counter, c1 = counter + 1, c2 = counter + 2, c3 = counter + 3;
+                orig[12] = _mm_setr_epi32(int(uint32_t(c0)), int(uint32_t(c1)), int(uint32_t(c2)), int(uint32_t(c3)));
+                orig[13] = _mm_setr_epi32(int(uint32_t(c0 >> 32)), int(uint32_t(c1 >> 32)), int(uint32_t(c2 >> 32)), int(uint32_t(c3 >> 32)));
+                for (int i = 0; i < 16; ++i) x[i] = orig[i];
+
+                auto qr = [&](int a, int b, int c, int d) noexcept {
+                    x[a] = _mm_add_epi32(x[a], x[b]); x[d] = rotl(_mm_xor_si128(x[d], x[a]), 16);
+                    x[c] = _mm_add_epi32(x[c], x[d]); x[b] = rotl(_mm_xor_si128(x[b], x[c]), 12);
+                    x[a] = _mm_add_epi32(x[a], x[b]); x[d] = rotl(_mm_xor_si128(x[d], x[a]), 8);
+                    x[c] = _mm_add_epi32(x[c], x[d]); x[b] = rotl(_mm_xor_si128(x[b], x[c]), 7);
+                };
+                for (int round = 0; round < 10; ++round) {
+                    qr(0, 4, 8, 12); qr(1, 5, 9, 13); qr(2, 6, 10, 14); qr(3, 7, 11, 15);
+                    qr(0, 5, 10, 15); qr(1, 6, 11, 12); qr(2, 7, 8, 13); qr(3, 4, 9, 14);
+                }
+                for (int i = 0; i < 16; ++i) x[i] = _mm_add_epi32(x[i], orig[i]);
+
+                // Transpose 4x4 groups: lane j of words 4g..4g+3 is bytes 16g..16g+15 of block j
+                for (int g = 0; g < 4; ++g) {
+                    __m128i t0 = _mm_unpacklo_epi32(x[4 * g + 0], x[4 * g + 1]);
+                    __m128i t1 = _mm_unpacklo_epi32(x[4 * g + 2], x[4 * g + 3]);
+                    __m128i t2 = _mm_unpackhi_epi32(x[4 * g + 0], x[4 * g + 1]);
+                    __m128i t3 = _mm_unpackhi_epi32(x[4 * g + 2], x[4 * g + 3]);
+                    _mm_storeu_si128(reinterpret_cast<__m128i*>(out + 0 * 64 + 16 * g), _mm_unpacklo_epi64(t0, t1));
+                    _mm_storeu_si128(reinterpret_cast<__m128i*>(out + 1 * 64 + 16 * g), _mm_unpackhi_epi64(t0, t1));
+                    _mm_storeu_si128(reinterpret_cast<__m128i*>(out + 2 * 64 + 16 * g), _mm_unpacklo_epi64(t2, t3));
+                    _mm_storeu_si128(reinterpret_cast<__m128i*>(out + 3 * 64 + 16 * g), _mm_unpackhi_epi64(t2, t3));
+                }
+            }
+#endif
+            for (; blocks > 0; --blocks, ++counter, out += 64) {
+                in[12] = static_cast<uint32_t>(counter);
+                in[13] = static_cast<uint32_t>(counter >> 32);
+                uint32_t x[16];
+                std::memcpy(x, in, sizeof(x));
+
+                auto qr = [&](int a, int b, int c, int d) noexcept {
+                    x[a] += x[b]; x[d] = rotl32(x[d] ^ x[a], 16);
+                    x[c] += x[d]; x[b] = rotl32(x[b] ^ x[c], 12);
+                    x[a] += x[b]; x[d] = rotl32(x[d] ^ x[a], 8);
+                    x[c] += x[d]; x[b] = rotl32(x[b] ^ x[c], 7);
+                };
+                for (int round = 0; round < 10; ++round) {
+                    qr(0, 4, 8, 12); qr(1, 5, 9, 13); qr(2, 6, 10, 14); qr(3, 7, 11, 15);
+                    qr(0, 5, 10, 15); qr(1, 6, 11, 12); qr(2, 7, 8, 13); qr(3, 4, 9, 14);
+                }
+                for (int i = 0; i < 16; ++i) store32le(out + 4 * i, x[i] + in[i]);
+            }
+        }
+
+    } // namespace detail
+
+    /**
+     * @class ChaCha20Engine
+     * @brief Buffered ChaCha20 CSPRNG with fast key erasure
+     *
+     * Default construction and reseed() take the key from the operating system.
+     * seed(value) derives the key from the value instead; that is reproducible
+     * and meant for tests only, as it is exactly as guessable as the value.
+     */
+    class ChaCha20Engine {
+    public:
+        using result_type = uint64_t;
+        static constexpr result_type min() noexcept { return 0; }
+        static constexpr result_type max() noexcept { return std::numeric_limits<uint64_t>::max(); }
+
+        static constexpr size_t KeyBytes{ 32 };
+        static constexpr size_t BlockBytes{ 64 };
+        static constexpr size_t BufferBytes{ 4096 };
+
+        /**
+         * @brief Construct with a key from the operating system
+         */
+        ChaCha20Engine() noexcept { reseed(); }
+
+        /**
+         * @brief Construct with a key derived from a value (not secure; for tests)
+         * @param value Seed value
+         */
+        explicit ChaCha20Engine(uint64_t value) noexcept { seed(value); }
+
+        /**
+         * @brief Copying would duplicate the key and the buffered keystream
+         */
+        ChaCha20Engine(ChaCha20Engine const&) = delete;
+        ChaCha20Engine& operator=(ChaCha20Engine const&) = delete;
+
+        /**
+         * @brief Take over the key and buffered keystream, wiping them from the source
+         *
+         * The source is left unkeyed and rekeys from the operating system
+         * before it produces anything again.
+         */
+        ChaCha20Engine(ChaCha20Engine&& other) noexcept
+            : m_key{ other.m_key }, m_buffer{ other.m_buffer }, m_position{ other.m_position }, m_keyed{ other.m_keyed } {
+            other.wipe();
+        }
+
+        ChaCha20Engine& operator=(ChaCha20Engine&& other) noexcept {
+            if (this != &other) {
+                m_key = other.m_key;
+                m_buffer = other.m_buffer;
+                m_position = other.m_position;
+                m_keyed = other.m_keyed;
+                other.wipe();
+            }
+            return *this;
+        }
+
+        ~ChaCha20Engine() { wipe(); }
+
+        /**
+         * @brief Take a new key from the operating system and discard buffered output
+         *
+         * If the operating system source fails, std::random_device is used. If
+         * that fails too there is no entropy to key from, and std::terminate()
+         * is called rather than continuing on a known or stale key.
+         *
+         * @return true if the key came from the operating system source
+         */
+        bool reseed() noexcept {
+            bool ok = detail::osRandom(m_key.data(), m_key.size());
+            if (!ok) {
+                try {
+                    std::random_device rd;
+                    for (size_t i = 0; i < m_key.size(); i += 4) {
+                        uint32_t v = rd();
+                        std::memcpy(m_key.data() + i, &v, 4);
+                    }
+                }
+                catch (...) {
+                    wipe();
+                    std::terminate();
+                }
+            }
+            m_position = BufferBytes;
+            m_keyed = true;
+            return ok;
+        }
+
+        /**
+         * @brief Derive the key from a value (reproducible, not secure)
+         * @param value Seed value
+         */
+        void seed(uint64_t value) noexcept {
+            SplitMix64 sm{ value };
+            for (size_t i = 0; i < m_key.size(); i += 8) {
+                uint64_t w = sm();
+                std::memcpy(m_key.data() + i, &w, 8);
+            }
+            m_position = BufferBytes;
+            m_keyed = true;
+        }
+
+        result_type operator()() noexcept {
+            if (m_position + sizeof(result_type) > BufferBytes) {
+                refill();
+            }
+            result_type r;
+            std::memcpy(&r, m_buffer.data() + m_position, sizeof(r));
+            std::memset(m_buffer.data() + m_position, 0, sizeof(r));
+            m_position += sizeof(r);
+            return r;
+        }
+
+        /**
+         * @brief Fill a byte range with keystream, erasing it from the buffer as it goes
+         * @param out Destination
+         */
+        void fill(std::span<std::byte> out) noexcept {
+            std::byte* dst = out.data();
+            size_t size = out.size();
+            while (size) {
+                if (m_position == BufferBytes) {
+                    refill();
+                }
+                size_t n = std::min(size, BufferBytes - m_position);
+                std::memcpy(dst, m_buffer.data() + m_position, n);
+                std::memset(m_buffer.data() + m_position, 0, n);
+                m_position += n;
+                dst += n;
+                size -= n;
+            }
+        }
+
+        void discard(uint64_t n) noexcept { while (n--) (*this)(); }
+
+    private:
+        std::array<unsigned char, KeyBytes> m_key{};
+        std::array<unsigned char, BufferBytes> m_buffer{};
+        size_t m_position{ BufferBytes };
+        bool m_keyed{ false };                  ///< False until keyed, and again after being moved from
+
+        /**
+         * @brief Erase key and buffer and mark the engine unkeyed
+         */
+        void wipe() noexcept {
+            detail::secureZero(m_key.data(), m_key.size());
+            detail::secureZero(m_buffer.data(), m_buffer.size());
+            m_position = BufferBytes;
+            m_keyed = false;
+        }
+
+        /**
+         * @brief Generate a full buffer, take the next key from its head, and erase it there
+         *
+         * An unkeyed engine first takes a key from the operating system.
+         */
+        void refill() noexcept {
+            if (!m_keyed) {
+                reseed();
+            }
+            detail::chacha20Blocks(m_key.data(), 0, 0, m_buffer.data(), BufferBytes / BlockBytes);
+            std::memcpy(m_key.data(), m_buffer.data(), KeyBytes);
+            std::memset(m_buffer.data(), 0, KeyBytes);
+            m_position = KeyBytes;
+        }
+    };
+
+    /**
+     * @brief Randomizer on the ChaCha20 CSPRNG, seeded from the operating system
+     *
+     * seed() and any reSeed request rekey from the operating system; the
+     * seed(uint32_t) overload and the seeded constructor are reproducible and
+     * therefore not secure.
+     */
+    using SecureRandomizer = BasicRandomizer<ChaCha20Engine>;
+
+} // namespace mz
+
+#endif // MZ_CHACHA20_ENGINE_HEADER_FILE
@@ -0,0 +1,336 @@
+/*
+MIT License
+
+Copyright (c) 2021-2024 Meysam Zare
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef MZ_COUNTER_RANDOM_HEADER_FILE
+#define MZ_COUNTER_RANDOM_HEADER_FILE
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+#include <array>
+#include <limits>
+#include <span>
+#include <vector>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+#include "Randomizer.h"
+
+/**
+ * @file CounterRandom.h
+ * @brief Counter-based random generation with Philox4x32-10
+ *
+ * Philox (Salmon et al., "Parallel Random Numbers: As Easy as 1, 2, 3", 2011)
+ * is a keyed bijection on 128-bit counters. Output word i of stream s under
+ * key k is a pure function of (k, s, i), so any worker can produce any slice
+ * of a stream directly, with no sequential state and no jump-ahead; the
+ * result does not depend on how the work was divided.
+ *
+ * Philox4x32 is used rather than 4x64 because its 32x32 multiplies map onto
+ * SIMD lanes: with AVX2 eight blocks are evaluated at once.
+ *
+ * Counter layout: (block index low, block index high, stream low, stream high),
+ * and block b yields 64-bit words 2b and 2b+1 (low half first).
+ *
+ * @author Meysam Zare
+ * @date 2026-10-18
+ */
+
+namespace mz {
+    namespace detail {
+
+        inline constexpr uint32_t PhiloxM0{ 0xD2511F53u };
+        inline constexpr uint32_t PhiloxM1{ 0xCD9E8D57u };
+        inline constexpr uint32_t PhiloxW0{ 0x9E3779B9u };
+        inline constexpr uint32_t PhiloxW1{ 0xBB67AE85u };
+
+        /**
+         * @brief One Philox4x32-10 block
+         * @param ctr Counter words
+         * @param key Key words
+         * @return Output words
+         */
+        constexpr std::array<uint32_t, 4> philox4x32(std::array<uint32_t, 4> ctr, std::array<uint32_t, 2> key) noexcept {
+            for (int round = 0; round < 10; ++round) {
+                if (round) {
+                    key[0] += PhiloxW0;
+                    key[1] += PhiloxW1;
+                }
+                const uint64_t p0 = uint64_t{ PhiloxM0 } * ctr[0];
+                const uint64_t p1 = uint64_t{ PhiloxM1 } * ctr[2];
+                ctr = { static_cast<uint32_t>(p1 >> 32) ^ ctr[1] ^ key[0], static_cast<uint32_t>(p1),
+                        static_cast<uint32_t>(p0 >> 32) ^ ctr[3] ^ key[1], static_cast<uint32_t>(p0) };
+            }
+            return ctr;
+        }
+
+        /**
+         * @brief The two 64-bit words of block `block` of a stream
+         */
+        constexpr std::array<uint64_t, 2> philoxBlock(uint64_t key, uint64_t stream, uint64_t block) noexcept {
+            const auto x = philox4x32(
+                { static_cast<uint32_t>(block), static_cast<uint32_t>(block >> 32),
+                  static_cast<uint32_t>(stream), static_cast<uint32_t>(stream >> 32) },
+                { static_cast<uint32_t>(key), static_cast<uint32_t>(key >> 32) });
+            return { x[0] | (uint64_t{ x[1] } << 32), x[2] | (uint64_t{ x[3] } << 32) };
+        }
+
+#if defined(__AVX2__)
+        /**
+         * @brief High and low halves of eight 32x32-bit products
+         */
+        inline void mulhilo8(__m256i a, __m256i m, __m256i& hi, __m256i& lo) noexcept {
+            const __m256i even = _mm256_mul_epu32(a, m);
+            const __m256i odd = _mm256_mul_epu32(_mm256_srli_epi64(a, 32), m);
+            lo = _mm256_blend_epi32(even, _mm256_slli_epi64(odd, 32), 0xAA);
+            hi = _mm256_blend_epi32(_mm256_srli_epi64(even, 32), odd, 0xAA);
+        }
+#endif
+
+        /**
+         * @brief Write blocks [first, first + blocks) of a stream, 16 bytes per block
+         */
+        inline void philoxBlocks(uint64_t key, uint64_t stream, uint64_t first, std::byte* out, size_t blocks) noexcept {
+            size_t b = 0;
+#if defined(__AVX2__)
+            const __m256i m0 = _mm256_set1_epi64x(PhiloxM0);
+            const __m256i m1 = _mm256_set1_epi64x(PhiloxM1);
+            const __m256i s0 = _mm256_set1_epi32(static_cast<int>(static_cast<uint32_t>(stream)));
+            const __m256i s1 = _mm256_set1_epi32(static_cast<int>(static_cast<uint32_t>(stream >> 32)));
+            for (; b + 8 <= blocks; b += 8) {
+                alignas(32) uint32_t lo[8], hi[8];
+                for (int j = 0; j < 8; ++j) {
+                    const uint64_t index = first + b + j;
+                    lo[j] = static_cast<uint32_t>(index);
+                    hi[j] = static_cast<uint32_t>(index >> 32);
+                }
+                __m256i c0 = _mm256_load_si256(reinterpret_cast<__m256i const*>(lo));
+                __m256i c1 = _mm256_load_si256(reinterpret_cast<__m256i const*>(hi));
+                __m256i c2 = s0, c3 = s1;
+                uint32_t k0 = static_cast<uint32_t>(key), k1 = static_cast<uint32_t>(key >> 32);
+                for (int round = 0; round < 10; ++round) {
+                    if (round) {
+                        k0 += PhiloxW0;
+                        k1 += PhiloxW1;
+                    }
+                    __m256i hi0, lo0, hi1, lo1;
+                    mulhilo8(c0, m0, hi0, lo0);
+                    mulhilo8(c2, m1, hi1, lo1);
+                    c0 = _mm256_xor_si256(_mm256_xor_si256(hi1, c1), _mm256_set1_epi32(static_cast<int>(k0)));
+                    c1 = lo1;
+                    c2 = _mm256_xor_si256(_mm256_xor_si256(hi0, c3), _mm256_set1_epi32(static_cast<int>(k1)));
+                    c3 = lo0;
+                }
+                // Lanes to block order: block j is (c0[j], c1[j], c2[j], c3[j])
+                const __m256i a0 = _mm256_unpacklo_epi32(c0, c1);   // w0 of blocks 0,1 | 4,5
+                const __m256i a1 = _mm256_unpackhi_epi32(c0, c1);   // w0 of blocks 2,3 | 6,7
+                const __m256i b0 = _mm256_unpacklo_epi32(c2, c3);   // w1 of blocks 0,1 | 4,5
+                const __m256i b1 = _mm256_unpackhi_epi32(c2, c3);   // w1 of blocks 2,3 | 6,7
+                const __m256i r0 = _mm256_unpacklo_epi64(a0, b0);   // blocks 0 | 4
+                const __m256i r1 = _mm256_unpackhi_epi64(a0, b0);   // blocks 1 | 5
+                const __m256i r2 = _mm256_unpacklo_epi64(a1, b1);   // blocks 2 | 6
+                const __m256i r3 = _mm256_unpackhi_epi64(a1, b1);   // blocks 3 | 7
+                std::byte* dst = out + b * 16;
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst), _mm256_permute2x128_si256(r0, r1, 0x20));
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + 32), _mm256_permute2x128_si256(r2, r3, 0x20));
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + 64), _mm256_permute2x128_si256(r0, r1, 0x31));
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + 96), _mm256_permute2x128_si256(r2, r3, 0x31));
+            }
+#endif
+            for (; b < blocks; ++b) {
+                const auto w = philoxBlock(key, stream, first + b);
+                std::memcpy(out + b * 16, w.data(), 16);
+            }
+        }
+
+    } // namespace detail
+
+    /**
+     * @class Philox4x32
+     * @brief Counter-based engine: a key, a stream and a position
+     *
+     * Behaves as a normal 64-bit engine, with O(1) discard. jump() moves to the
+     * next stream and longJump() 2^32 streams ahead, keeping the position;
+     * distinct streams never share a counter, so the JumpableEngine guarantees
+     * hold for 2^64 outputs per stream. fill() evaluates whole blocks with SIMD,
+     * which BasicRandomizer::randomize uses for integer and floating-point spans.
+     */
+    class Philox4x32 {
+    public:
+        using result_type = uint64_t;
+        static constexpr result_type min() noexcept { return 0; }
+        static constexpr result_type max() noexcept { return std::numeric_limits<uint64_t>::max(); }
+        static constexpr uint64_t DefaultSeed{ 5489u };
+        static constexpr uint64_t MaxLongJumps{ uint64_t{ 1 } << 32 };    ///< Distinct longJump() streams before the stream index wraps
+
+        constexpr Philox4x32() noexcept { seed(DefaultSeed); }
+
+        /**
+         * @brief Construct from a key and a stream, at position 0
+         * @param key Key (any value)
+         * @param stream Stream index
+         */
+        constexpr Philox4x32(uint64_t key, uint64_t stream) noexcept : m_key{ key }, m_stream{ stream } {}
+
+        /**
+         * @brief Construct with the key derived from a seed, on stream 0
+         */
+        constexpr explicit Philox4x32(uint64_t seed) noexcept { this->seed(seed); }
+
+        constexpr void seed(uint64_t seed) noexcept {
+            m_key = SplitMix64{ seed }();
+            m_stream = 0;
+            m_position = 0;
+            m_cacheBlock = NoBlock;
+        }
+
+        /**
+         * @brief Word `index` of a stream: the pure counter-based definition
+         * @param key Key
+         * @param stream Stream index
+         * @param index Word index
+         * @return The word, identical to the index-th output of Philox4x32(key, stream)
+         */
+        [[nodiscard]] static constexpr uint64_t at(uint64_t key, uint64_t stream, uint64_t index) noexcept {
+            return detail::philoxBlock(key, stream, index >> 1)[index & 1];
+        }
+
+        /**
+         * @brief Words [first, first + out.size()) of a stream, computed in SIMD batches
+         * @param key Key
+         * @param stream Stream index
+         * @param first Index of the first word
+         * @param out Destination
+         */
+        static void generate(uint64_t key, uint64_t stream, uint64_t first, std::span<uint64_t> out) noexcept {
+            size_t i = 0;
+            if ((first & 1) && !out.empty()) {
+                out[i++] = at(key, stream, first++);
+            }
+            const size_t blocks = (out.size() - i) / 2;
+            detail::philoxBlocks(key, stream, first >> 1, reinterpret_cast<std::byte*>(out.data() + i), blocks);
+            i += 2 * blocks;
+            first += 2 * blocks;
+            if (i < out.size()) {
+                out[i] = at(key, stream, first);
+            }
+        }
+
+        constexpr result_type operator()() noexcept {
+            const uint64_t index = m_position++;
+            if ((index >> 1) != m_cacheBlock) {
+                m_cacheBlock = index >> 1;
+                m_cache = detail::philoxBlock(m_key, m_stream, m_cacheBlock);
+            }
+            return m_cache[index & 1];
+        }
+
+        /**
+         * @brief Fill bytes with the next outputs (little-endian words), whole blocks at a time
+         *
+         * A trailing partial word consumes a whole output.
+         */
+        void fill(std::span<std::byte> out) noexcept {
+            std::byte* p = out.data();
+            size_t n = out.size();
+            if ((m_position & 1) && n >= 8) {
+                const uint64_t w = (*this)();
+                std::memcpy(p, &w, 8);
+                p += 8;
+                n -= 8;
+            }
+            if (!(m_position & 1)) {
+                const size_t blocks = n / 16;
+                detail::philoxBlocks(m_key, m_stream, m_position >> 1, p, blocks);
+                m_position += 2 * blocks;
+                p += blocks * 16;
+                n -= blocks * 16;
+            }
+            while (n) {
+                const uint64_t w = (*this)();
+                const size_t k = n < 8 ? n : 8;
+                std::memcpy(p, &w, k);
+                p += k;
+                n -= k;
+            }
+        }
+
+        constexpr void discard(uint64_t n) noexcept { m_position += n; }
+
+        /**
+         * @brief Move to the next stream at the same position
+         */
+        constexpr void jump() noexcept { ++m_stream; }
+
+        /**
+         * @brief Move 2^32 streams ahead at the same position
+         */
+        constexpr void longJump() noexcept { m_stream += uint64_t{ 1 } << 32; }
+
+        /**
+         * @brief n engines on consecutive streams; this engine moves past the last one
+         */
+        [[nodiscard]] std::vector<Philox4x32> split(size_t n) { return detail::split(*this, n); }
+
+        /**
+         * @brief Engine for stream `index` of a seed
+         */
+        [[nodiscard]] static constexpr Philox4x32 stream(uint64_t seed, uint64_t index) noexcept {
+            return Philox4x32{ SplitMix64{ seed }(), index };
+        }
+
+        [[nodiscard]] constexpr uint64_t key() const noexcept { return m_key; }
+        [[nodiscard]] constexpr uint64_t streamIndex() const noexcept { return m_stream; }
+        [[nodiscard]] constexpr uint64_t position() const noexcept { return m_position; }
+
+        /**
+         * @brief Move to an absolute position in the current stream
+         */
+        constexpr void setPosition(uint64_t position) noexcept { m_position = position; }
+
+        friend constexpr bool operator==(Philox4x32 const& a, Philox4x32 const& b) noexcept {
+            return a.m_key == b.m_key && a.m_stream == b.m_stream && a.m_position == b.m_position;
+        }
+
+    private:
+        static constexpr uint64_t NoBlock{ UINT64_MAX };    ///< Never a valid block index (positions are < 2^64)
+
+        uint64_t m_key{ 0 };
+        uint64_t m_stream{ 0 };
+        uint64_t m_position{ 0 };                          ///< Index of the next output word
+        uint64_t m_cacheBlock{ NoBlock };
+        std::array<uint64_t, 2> m_cache{};
+    };
+
+    /**
+     * @brief Randomizer on the counter-based Philox4x32-10 engine
+     */
+    using PhiloxRandomizer = BasicRandomizer<Philox4x32>;
+
+} // namespace mz
+
+#endif // MZ_COUNTER_RANDOM_HEADER_FILE
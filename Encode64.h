@@ -2,8 +2,21 @@
 #define MZ_UTILITIES_ENCODER64_HEADER_FILE
 #pragma once
 
-#include <string>
+#include <cstdint>
+#include <cstddef>
+#include <array>
 #include <concepts>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSSE3__)
+#include <tmmintrin.h>
+#endif
 
 /*
 *  encode64.h
@@ -48,10 +61,318 @@
     - Supports all std::integral types (uint8_t, uint16_t, uint32_t, uint64_t, etc.).
     - Compile-time constexpr encoding for constant expressions.
     - Operator() for convenient functor-style usage.
+
+    Base64 is a full RFC 4648 codec for byte buffers, standard (+ /) and
+    URL-safe (- _) alphabets, with or without '=' padding. It works on
+    caller-provided spans and never allocates; size the output with
+    encodedLength / decodedLength. The encoder and decoder process 12 or 24
+    input bytes per step with SSSE3 or AVX2 when the build enables them.
+
+    Usage:
+    ------
+    std::vector<char> text(mz::Base64::encodedLength(data.size()));
+    mz::Base64::encode(data, text);
+
+    std::vector<uint8_t> bytes(mz::Base64::decodedLength(encoded));
+    if (auto n = mz::Base64::decode(encoded, bytes)) { ... bytes[0 .. *n) ... }
+
+    std::string s = mz::Encoder64::to_string(data);         // allocating helpers
+    if (auto d = mz::Decoder64::from_string(s)) { ... *d ... }
 */
 
 namespace mz {
 
+    /*
+        Base64 alphabets of RFC 4648.
+    */
+    enum class Base64Alphabet : uint8_t {
+        Standard,   // A-Z a-z 0-9 + /  (section 4)
+        Url         // A-Z a-z 0-9 - _  (section 5, safe in URLs and file names)
+    };
+
+    namespace detail {
+
+        inline constexpr char base64Standard[65]{ "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/" };
+        inline constexpr char base64Url[65]{ "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789-_" };
+
+        constexpr char const* base64Chars(Base64Alphabet alphabet) noexcept {
+            return alphabet == Base64Alphabet::Url ? base64Url : base64Standard;
+        }
+
+        // Character -> sextet value; 0x100 marks characters outside the alphabet.
+        constexpr std::array<uint32_t, 256> base64Values(Base64Alphabet alphabet) noexcept {
+            std::array<uint32_t, 256> values{};
+            values.fill(0x100);
+            char const* chars = base64Chars(alphabet);
+            for (uint32_t i = 0; i < 64; ++i) values[static_cast<uint8_t>(chars[i])] = i;
+            return values;
+        }
+
+        inline constexpr std::array<uint32_t, 256> base64StandardValues{ base64Values(Base64Alphabet::Standard) };
+        inline constexpr std::array<uint32_t, 256> base64UrlValues{ base64Values(Base64Alphabet::Url) };
+
+#if defined(__SSSE3__) || defined(__AVX2__)
+        /*
+            Encoding (Mula & Lemire): spread each 3-byte group over a 32-bit lane,
+            isolate the four sextets with two multiplies, then map sextet ranges
+            to characters with one offset table lookup. Only entries 11 and 12 of
+            the offset table depend on the alphabet.
+        */
+        inline __m128i base64EncodeBlock(__m128i in, __m128i offsets) noexcept {
+            in = _mm_shuffle_epi8(in, _mm_set_epi8(10, 11, 9, 10, 7, 8, 6, 7, 4, 5, 3, 4, 1, 2, 0, 1));
+            const __m128i ac = _mm_mulhi_epu16(_mm_and_si128(in, _mm_set1_epi32(0x0FC0FC00)), _mm_set1_epi32(0x04000040));
+            const __m128i bd = _mm_mullo_epi16(_mm_and_si128(in, _mm_set1_epi32(0x003F03F0)), _mm_set1_epi32(0x01000010));
+            const __m128i sextets = _mm_or_si128(ac, bd);
+            __m128i range = _mm_subs_epu8(sextets, _mm_set1_epi8(51));
+            range = _mm_or_si128(range, _mm_and_si128(_mm_cmpgt_epi8(_mm_set1_epi8(26), sextets), _mm_set1_epi8(13)));
+            return _mm_add_epi8(sextets, _mm_shuffle_epi8(offsets, range));
+        }
+
+        inline __m128i base64EncodeOffsets(Base64Alphabet alphabet) noexcept {
+            char const* chars = base64Chars(alphabet);
+            const char d = '0' - 52;
+            return _mm_setr_epi8('a' - 26, d, d, d, d, d, d, d, d, d, d,
+                static_cast<char>(chars[62] - 62), static_cast<char>(chars[63] - 63), 'A', 0, 0);
+        }
+
+        /*
+            Decoding: classify each character by range (A-Z, a-z, 0-9 and the two
+            alphabet-specific symbols) to get both its offset and its validity,
+            then pack four sextets per 32-bit lane into three bytes.
+        */
+        inline __m128i base64InRange(__m128i v, char lo, char hi) noexcept {
+            return _mm_and_si128(_mm_cmpgt_epi8(v, _mm_set1_epi8(static_cast<char>(lo - 1))),
+                _mm_cmpgt_epi8(_mm_set1_epi8(static_cast<char>(hi + 1)), v));
+        }
+
+        inline bool base64DecodeBlock(__m128i in, char c62, char c63, __m128i& packed) noexcept {
+            const __m128i upper = base64InRange(in, 'A', 'Z');
+            const __m128i lower = base64InRange(in, 'a', 'z');
+            const __m128i digit = base64InRange(in, '0', '9');
+            const __m128i sym62 = _mm_cmpeq_epi8(in, _mm_set1_epi8(c62));
+            const __m128i sym63 = _mm_cmpeq_epi8(in, _mm_set1_epi8(c63));
+            const __m128i valid = _mm_or_si128(_mm_or_si128(upper, lower), _mm_or_si128(digit, _mm_or_si128(sym62, sym63)));
+            if (_mm_movemask_epi8(valid) != 0xFFFF) return false;
+
+            __m128i offset = _mm_and_si128(upper, _mm_set1_epi8(-'A'));
+            offset = _mm_or_si128(offset, _mm_and_si128(lower, _mm_set1_epi8(26 - 'a')));
+            offset = _mm_or_si128(offset, _mm_and_si128(digit, _mm_set1_epi8(52 - '0')));
+            offset = _mm_or_si128(offset, _mm_and_si128(sym62, _mm_set1_epi8(static_cast<char>(62 - c62))));
+            offset = _mm_or_si128(offset, _mm_and_si128(sym63, _mm_set1_epi8(static_cast<char>(63 - c63))));
+            const __m128i sextets = _mm_add_epi8(in, offset);
+
+            const __m128i pairs = _mm_maddubs_epi16(sextets, _mm_set1_epi32(0x01400140));
+            const __m128i words = _mm_madd_epi16(pairs, _mm_set1_epi32(0x00011000));
+            packed = _mm_shuffle_epi8(words, _mm_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1));
+            return true;
+        }
+#endif
+
+#if defined(__AVX2__)
+        // Two 12-byte groups per call, one in each 128-bit lane.
+        inline __m256i base64EncodeBlock(__m256i in, __m256i offsets) noexcept {
+            in = _mm256_shuffle_epi8(in, _mm256_set_epi8(10, 11, 9, 10, 7, 8, 6, 7, 4, 5, 3, 4, 1, 2, 0, 1,
+                10, 11, 9, 10, 7, 8, 6, 7, 4, 5, 3, 4, 1, 2, 0, 1));
+            const __m256i ac = _mm256_mulhi_epu16(_mm256_and_si256(in, _mm256_set1_epi32(0x0FC0FC00)), _mm256_set1_epi32(0x04000040));
+            const __m256i bd = _mm256_mullo_epi16(_mm256_and_si256(in, _mm256_set1_epi32(0x003F03F0)), _mm256_set1_epi32(0x01000010));
+            const __m256i sextets = _mm256_or_si256(ac, bd);
+            __m256i range = _mm256_subs_epu8(sextets, _mm256_set1_epi8(51));
+            range = _mm256_or_si256(range, _mm256_and_si256(_mm256_cmpgt_epi8(_mm256_set1_epi8(26), sextets), _mm256_set1_epi8(13)));
+            return _mm256_add_epi8(sextets, _mm256_shuffle_epi8(offsets, range));
+        }
+
+        inline __m256i base64InRange(__m256i v, char lo, char hi) noexcept {
+            return _mm256_and_si256(_mm256_cmpgt_epi8(v, _mm256_set1_epi8(static_cast<char>(lo - 1))),
+                _mm256_cmpgt_epi8(_mm256_set1_epi8(static_cast<char>(hi + 1)), v));
+        }
+
+        // 32 characters -> 24 bytes in the low 24 bytes of `packed`.
+        inline bool base64DecodeBlock(__m256i in, char c62, char c63, __m256i& packed) noexcept {
+            const __m256i upper = base64InRange(in, 'A', 'Z');
+            const __m256i lower = base64InRange(in, 'a', 'z');
+            const __m256i digit = base64InRange(in, '0', '9');
+            const __m256i sym62 = _mm256_cmpeq_epi8(in, _mm256_set1_epi8(c62));
+            const __m256i sym63 = _mm256_cmpeq_epi8(in, _mm256_set1_epi8(c63));
+            const __m256i valid = _mm256_or_si256(_mm256_or_si256(upper, lower), _mm256_or_si256(digit, _mm256_or_si256(sym62, sym63)));
+            if (_mm256_movemask_epi8(valid) != -1) return false;
+
+            __m256i offset = _mm256_and_si256(upper, _mm256_set1_epi8(-'A'));
+            offset = _mm256_or_si256(offset, _mm256_and_si256(lower, _mm256_set1_epi8(26 - 'a')));
+            offset = _mm256_or_si256(offset, _mm256_and_si256(digit, _mm256_set1_epi8(52 - '0')));
+            offset = _mm256_or_si256(offset, _mm256_and_si256(sym62, _mm256_set1_epi8(static_cast<char>(62 - c62))));
+            offset = _mm256_or_si256(offset, _mm256_and_si256(sym63, _mm256_set1_epi8(static_cast<char>(63 - c63))));
+            const __m256i sextets = _mm256_add_epi8(in, offset);
+
+            const __m256i pairs = _mm256_maddubs_epi16(sextets, _mm256_set1_epi32(0x01400140));
+            const __m256i words = _mm256_madd_epi16(pairs, _mm256_set1_epi32(0x00011000));
+            const __m256i lanes = _mm256_shuffle_epi8(words, _mm256_setr_epi8(
+                2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1,
+                2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1));
+            packed = _mm256_permutevar8x32_epi32(lanes, _mm256_setr_epi32(0, 1, 2, 4, 5, 6, 3, 7));
+            return true;
+        }
+#endif
+
+    } // namespace detail
+
+    /*
+        RFC 4648 Base64 over byte buffers. All functions write into caller
+        memory and never allocate.
+    */
+    class Base64 {
+    public:
+        /*
+            Number of characters encode() writes for `bytes` input bytes.
+        */
+        static constexpr size_t encodedLength(size_t bytes, bool padding = true) noexcept {
+            if (padding) return (bytes + 2) / 3 * 4;
+            const size_t rest = bytes % 3;
+            return bytes / 3 * 4 + (rest ? rest + 1 : 0);
+        }
+
+        /*
+            Number of bytes decode() writes for `text`, padded or not (exact for
+            valid input).
+        */
+        static constexpr size_t decodedLength(std::string_view text) noexcept {
+            const size_t chars = text.size() - paddingOf(text);
+            const size_t rest = chars % 4;
+            return chars / 4 * 3 + (rest > 1 ? rest - 1 : 0);
+        }
+
+        /*
+            Encodes `data` into `out`.
+            Returns the number of characters written, or std::nullopt if `out`
+            is shorter than encodedLength(data.size(), padding).
+        */
+        static std::optional<size_t> encode(std::span<const uint8_t> data, std::span<char> out,
+            Base64Alphabet alphabet = Base64Alphabet::Standard, bool padding = true) noexcept {
+            const size_t length = encodedLength(data.size(), padding);
+            if (out.size() < length) return std::nullopt;
+
+            uint8_t const* in = data.data();
+            const size_t n = data.size();
+            char* o = out.data();
+            size_t i = 0;
+#if defined(__AVX2__)
+            const __m128i offsets128 = detail::base64EncodeOffsets(alphabet);
+            const __m256i offsets = _mm256_broadcastsi128_si256(offsets128);
+            for (; i + 28 <= n; i += 24, o += 32) {
+                const __m256i block = _mm256_inserti128_si256(
+                    _mm256_castsi128_si256(_mm_loadu_si128(reinterpret_cast<__m128i const*>(in + i))),
+                    _mm_loadu_si128(reinterpret_cast<__m128i const*>(in + i + 12)), 1);
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(o), detail::base64EncodeBlock(block, offsets));
+            }
+#elif defined(__SSSE3__)
+            const __m128i offsets128 = detail::base64EncodeOffsets(alphabet);
+#endif
+#if defined(__SSSE3__) || defined(__AVX2__)
+            for (; i + 16 <= n; i += 12, o += 16) {
+                const __m128i block = _mm_loadu_si128(reinterpret_cast<__m128i const*>(in + i));
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(o), detail::base64EncodeBlock(block, offsets128));
+            }
+#endif
+            char const* chars = detail::base64Chars(alphabet);
+            for (; i + 3 <= n; i += 3, o += 4) {
+                const uint32_t v = (uint32_t{ in[i] } << 16) | (uint32_t{ in[i + 1] } << 8) | in[i + 2];
+                o[0] = chars[v >> 18];
+                o[1] = chars[(v >> 12) & 0x3F];
+                o[2] = chars[(v >> 6) & 0x3F];
+                o[3] = chars[v & 0x3F];
+            }
+            if (const size_t rest = n - i) {
+                const uint32_t v = (uint32_t{ in[i] } << 16) | (rest == 2 ? uint32_t{ in[i + 1] } << 8 : 0u);
+                *o++ = chars[v >> 18];
+                *o++ = chars[(v >> 12) & 0x3F];
+                if (rest == 2) *o++ = chars[(v >> 6) & 0x3F];
+                if (padding) {
+                    if (rest == 1) *o++ = '=';
+                    *o++ = '=';
+                }
+            }
+            return length;
+        }
+
+        /*
+            Decodes `text` into `out`, validating it completely.
+            Padding is optional, but if present the text must be a multiple of
+            4 characters long. Rejected: characters outside the alphabet
+            (including whitespace and line breaks), misplaced '=', a final group
+            of one character, and non-zero unused bits in the final group (so
+            every byte string has exactly one accepted encoding per alphabet).
+            Returns the number of bytes written, or std::nullopt if the text is
+            invalid or `out` is shorter than decodedLength(text). On failure the
+            contents of `out` are unspecified.
+        */
+        static std::optional<size_t> decode(std::string_view text, std::span<uint8_t> out,
+            Base64Alphabet alphabet = Base64Alphabet::Standard) noexcept {
+            const size_t n = text.size() - paddingOf(text);
+            if (n % 4 == 1) return std::nullopt;
+            const size_t length = decodedLength(text);
+            if (out.size() < length) return std::nullopt;
+
+            char const* in = text.data();
+            uint8_t* o = out.data();
+            size_t i = 0;
+#if defined(__SSSE3__) || defined(__AVX2__)
+            uint8_t* const end = o + out.size();
+            char const* chars = detail::base64Chars(alphabet);
+#endif
+#if defined(__AVX2__)
+            for (; i + 32 <= n && o + 32 <= end; i += 32, o += 24) {
+                __m256i packed;
+                if (!detail::base64DecodeBlock(_mm256_loadu_si256(reinterpret_cast<__m256i const*>(in + i)),
+                    chars[62], chars[63], packed)) {
+                    return std::nullopt;
+                }
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(o), packed);
+            }
+#endif
+#if defined(__SSSE3__) || defined(__AVX2__)
+            for (; i + 16 <= n && o + 16 <= end; i += 16, o += 12) {
+                __m128i packed;
+                if (!detail::base64DecodeBlock(_mm_loadu_si128(reinterpret_cast<__m128i const*>(in + i)),
+                    chars[62], chars[63], packed)) {
+                    return std::nullopt;
+                }
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(o), packed);
+            }
+#endif
+            uint32_t const* values = alphabet == Base64Alphabet::Url
+                ? detail::base64UrlValues.data() : detail::base64StandardValues.data();
+            auto value = [values](char c) noexcept { return values[static_cast<uint8_t>(c)]; };
+
+            uint32_t invalid = 0;
+            for (; i + 4 <= n; i += 4, o += 3) {
+                const uint32_t a = value(in[i]), b = value(in[i + 1]), c = value(in[i + 2]), d = value(in[i + 3]);
+                invalid |= a | b | c | d;
+                const uint32_t v = (a << 18) | (b << 12) | (c << 6) | d;
+                o[0] = static_cast<uint8_t>(v >> 16);
+                o[1] = static_cast<uint8_t>(v >> 8);
+                o[2] = static_cast<uint8_t>(v);
+            }
+            if (const size_t rest = n - i) {
+                const uint32_t a = value(in[i]), b = value(in[i + 1]), c = rest == 3 ? value(in[i + 2]) : 0;
+                invalid |= a | b | c;
+                const uint32_t v = (a << 18) | (b << 12) | (c << 6);
+                // Unused low bits of the last character must be zero
+                if (v & (rest == 2 ? 0xFFFFu : 0xFFu)) return std::nullopt;
+                *o++ = static_cast<uint8_t>(v >> 16);
+                if (rest == 3) *o++ = static_cast<uint8_t>(v >> 8);
+            }
+            if (invalid & 0x100) return std::nullopt;
+            return length;
+        }
+
+    private:
+        // '=' characters to strip: at most two, and only from a multiple of 4.
+        static constexpr size_t paddingOf(std::string_view text) noexcept {
+            if (text.empty() || text.size() % 4 != 0 || text.back() != '=') return 0;
+            return text[text.size() - 2] == '=' ? 2 : 1;
+        }
+    };
+
+
     class Encoder64 {
         // 64-character alphabet for encoding (A-Z, a-z, 0-9, +, /)
         static constexpr char alphabet[64]{
@@ -115,6 +436,43 @@ namespace mz {
         constexpr std::string operator()(T value) const noexcept {
             return to_string(value);
         }
+
+        /*
+            Base64-encodes a byte buffer (standard alphabet, padded).
+        */
+        static std::string to_string(std::span<const uint8_t> data) {
+            std::string s(Base64::encodedLength(data.size()), '\0');
+            Base64::encode(data, s);
+            return s;
+        }
+
+        /*
+            Base64-encodes a byte buffer with the URL-safe alphabet, unpadded
+            by default as in JWT and most URL uses.
+        */
+        static std::string to_url_safe_string(std::span<const uint8_t> data, bool padding = false) {
+            std::string s(Base64::encodedLength(data.size(), padding), '\0');
+            Base64::encode(data, s, Base64Alphabet::Url, padding);
+            return s;
+        }
+    };
+
+    /*
+        Allocating counterpart of Encoder64::to_string / to_url_safe_string.
+    */
+    class Decoder64 {
+    public:
+        /*
+            Decodes Base64 text, padded or not.
+            Returns std::nullopt if the text is invalid (see Base64::decode).
+        */
+        static std::optional<std::vector<uint8_t>> from_string(std::string_view text, Base64Alphabet alphabet = Base64Alphabet::Standard) {
+            std::vector<uint8_t> bytes(Base64::decodedLength(text));
+            const auto n = Base64::decode(text, bytes, alphabet);
+            if (!n) return std::nullopt;
+            bytes.resize(*n);
+            return bytes;
+        }
     };
 
 } // namespace mz
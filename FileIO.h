@@ -46,16 +46,21 @@
 #ifdef _MSC_VER
 #include <io.h>
 #include <fcntl.h>
+#include <mutex>
 #else
 #include <unistd.h>
+#include <fcntl.h>
 #include <sys/stat.h>
+#include <sys/uio.h>
+#include <cerrno>
+#include <climits>
 #endif
 
 #include <span>
+#include <string>
 #include <filesystem>
 
 #include "EndianConcepts.h"
-#include "coord.h"
 
 namespace mz {
     namespace io {
@@ -146,13 +151,13 @@ namespace mz {
              * Maps standard system error codes to the appropriate error flags,
              * facilitating consistent error handling across platforms.
              */
-            constexpr void fill_open_errors(errno_t err) noexcept {
+            constexpr void fill_open_errors(int err) noexcept {
                 value = 0;
-                eacces = err & EACCES;      // path is a directory, or open-for-writing a read-only file
-                eexists = err & EEXIST;     // _O_CREAT and _O_EXCL, but filename already exists.
-                einval = err & EINVAL;      // Invalid oflag, shflag, pmode, or pfh or filename was a null pointer. in chage size if size < 0
-                emfile = err & EMFILE;      // No more file descriptors available.
-                enoent = err & ENOENT;      // File or path not found
+                eacces = err == EACCES;     // path is a directory, or open-for-writing a read-only file
+                eexists = err == EEXIST;    // _O_CREAT and _O_EXCL, but filename already exists.
+                einval = err == EINVAL;     // Invalid oflag, shflag, pmode, or pfh or filename was a null pointer. in chage size if size < 0
+                emfile = err == EMFILE;     // No more file descriptors available.
+                enoent = err == ENOENT;     // File or path not found
                 //eacces = err & EBADF;     // in change size when the file is read only
                 //eacces = err & ENOSPC;    // in change size when no space left on disk
             }
@@ -219,6 +224,20 @@ namespace mz {
              */
             constexpr bool is_open() const noexcept { return f_handle != -1; }
 
+            /**
+             * @brief Checks if the file was opened with O_APPEND
+             * @return true if every write goes to the end of the file
+             */
+            constexpr bool is_append() const noexcept { return f_handle != -1 && f_append; }
+
+            /**
+             * @brief Clears the fail bits while preserving the bad bits
+             *
+             * Allows a long-lived handle to keep writing after a transient
+             * operational failure, e.g. a full disk that has since been cleared.
+             */
+            constexpr void clear() noexcept { e_flags.reset(); }
+
             //
             // BASIC FILE OPERATIONS
             //
@@ -266,7 +285,30 @@ namespace mz {
                 if (is_open() && good()) {
                     int res = os_commit();
                     if (res) {
-                        e_flags.invalid = 1;
+                        e_flags.commit = 1;
+                        return true;
+                    }
+                    return false;
+                }
+                return true;
+            }
+
+            /**
+             * @brief Commits file data to disk without forcing a metadata update
+             *
+             * Lighter variant of commit() that maps to fdatasync where the platform
+             * provides it. Timestamps may be persisted lazily, but the file size
+             * and content are durable once this returns.
+             * Available only for files opened with write access.
+             *
+             * @return true if an error occurred, false on success
+             */
+            bool datasync() noexcept requires (WRITER)
+            {
+                if (is_open() && good()) {
+                    int res = os_datasync();
+                    if (res) {
+                        e_flags.commit = 1;
                         return true;
                     }
                     return false;
@@ -288,8 +330,8 @@ namespace mz {
                 auto err = os_chsize(NewSize);
                 if (err) {
                     e_flags.invalid = 1;
-                    e_flags.eacces |= err & (EBADF | ENOSPC);
-                    e_flags.einval |= err & EINVAL;
+                    e_flags.eacces |= (err == EBADF || err == ENOSPC);
+                    e_flags.einval |= (err == EINVAL);
                     return true;
                 }
                 return false;
@@ -358,7 +400,7 @@ namespace mz {
             bool read(void* _Buf, size_t Size) const noexcept requires (READER)
             {
                 auto res = os_read(_Buf, unsigned(Size));
-                if (res == Size) {
+                if (res >= 0 && size_t(res) == Size) {
                     return false;
                 }
                 else {
@@ -381,7 +423,7 @@ namespace mz {
              */
             bool write(void const* _Buf, size_t Size) noexcept requires (WRITER) {
                 auto res = os_write(_Buf, unsigned(Size));
-                if (res == Size) {
+                if (res >= 0 && size_t(res) == Size) {
                     return false;
                 }
                 else {
@@ -393,6 +435,80 @@ namespace mz {
                 }
             }
 
+            /**
+             * @brief Writes a sequence of strings with a single gather operation
+             *
+             * The strings are written back to back, without length prefixes, using
+             * writev on POSIX systems. Sequences longer than IOV_MAX are split into
+             * as few calls as possible and short writes are resumed. Platforms without
+             * a gather call concatenate the strings and issue a single write.
+             * Available only for files opened with write access.
+             *
+             * @param Bufs Strings to write, in order
+             * @return true if an error occurred or not every byte was written, false on success
+             */
+            bool writev(std::span<std::string const> Bufs) noexcept requires (WRITER)
+            {
+                if (os_writev(Bufs)) {
+                    e_flags.write = 1;
+                    return true;
+                }
+                return false;
+            }
+
+            /**
+             * @brief Writes data at an absolute offset without touching the error flags
+             *
+             * Uses pwrite on POSIX systems, which leaves the file position
+             * untouched. The Windows CRT has no positional write, so there the
+             * call seeks, writes and restores the position under a process-wide
+             * lock. Short writes are resumed. Nothing in the handle is modified,
+             * so several threads may write disjoint ranges of the same file
+             * concurrently and report a failure with set_write_error() after
+             * they have been joined.
+             * Fails on files opened with O_APPEND, where both platforms would
+             * ignore the offset and append instead.
+             * Available only for files opened with write access.
+             *
+             * @param _Buf Data to write
+             * @param Size Number of bytes to write
+             * @param Offset File offset of the first byte
+             * @return true if an error occurred or not every byte was written, false on success
+             */
+            bool pwrite(void const* _Buf, size_t Size, int64_t Offset) noexcept requires (WRITER)
+            {
+                if (f_append) {
+                    return true;
+                }
+                return os_pwrite(_Buf, Size, Offset) != 0;
+            }
+
+            /**
+             * @brief Writes data at an absolute offset
+             *
+             * Single-threaded counterpart of pwrite() that records a failure
+             * in the error flags.
+             * Available only for files opened with write access.
+             *
+             * @param _Buf Data to write
+             * @param Size Number of bytes to write
+             * @param Offset File offset of the first byte
+             * @return true if an error occurred or not every byte was written, false on success
+             */
+            bool write_at(void const* _Buf, size_t Size, int64_t Offset) noexcept requires (WRITER)
+            {
+                if (pwrite(_Buf, Size, Offset)) {
+                    e_flags.write = 1;
+                    return true;
+                }
+                return false;
+            }
+
+            /**
+             * @brief Records a write failure detected outside the handle, e.g. by pwrite() workers
+             */
+            constexpr void set_write_error() noexcept requires (WRITER) { e_flags.write = 1; }
+
             //
             // READ OPERATIONS
             //
@@ -432,13 +548,13 @@ namespace mz {
              *
              * @tparam T Type of the values (must be trivially copyable and non-const)
              * @param P Pointer to the array where values will be stored
-             * @param N Number of values to read
+             * @param Count Number of values to read
              * @return true if an error occurred, false on success
              */
             template <mz::endian::TrivialTypeNonConst T>
-            bool read(T* P, size_t N) const noexcept requires (READER)
+            bool read(T* P, size_t Count) const noexcept requires (READER)
             {
-                return read((void*)P, sizeof(T) * N);
+                return read((void*)P, sizeof(T) * Count);
             }
 
             /**
@@ -446,21 +562,21 @@ namespace mz {
              *
              * @tparam T Type of the values (must support endian swapping and be non-const)
              * @param P Pointer to the array where values will be stored
-             * @param N Number of values to read
+             * @param Count Number of values to read
              * @return true if an error occurred, false on success
              */
             template <mz::endian::SwapTypeNonConst T>
-            bool readEndian(T* P, size_t N) const noexcept requires (READER)
+            bool readEndian(T* P, size_t Count) const noexcept requires (READER)
             {
                 if constexpr (mz::endian::endian_mismatch)
                 {
                     // Read and convert each value individually when endianness differs
-                    for (size_t i = 0; i < N && good(); i++) { readEndian(P[i]); }
+                    for (size_t i = 0; i < Count && good(); i++) { readEndian(P[i]); }
                     return fail();
                 }
                 else {
                     // No conversion needed if endianness matches
-                    return read(P, N);
+                    return read(P, Count);
                 }
             }
 
@@ -468,12 +584,12 @@ namespace mz {
              * @brief Reads values into a span
              *
              * @tparam T Type of the values (must be trivially copyable and non-const)
-             * @tparam N Size of the span (deduced from the parameter)
+             * @tparam Extent Size of the span (deduced from the parameter)
              * @param SP Span where values will be stored
              * @return true if an error occurred, false on success
              */
-            template <mz::endian::TrivialTypeNonConst T, size_t N>
-            bool read(std::span<T, N> SP) const noexcept requires (READER)
+            template <mz::endian::TrivialTypeNonConst T, size_t Extent>
+            bool read(std::span<T, Extent> SP) const noexcept requires (READER)
             {
                 return read(SP.data(), SP.size());
             }
@@ -482,12 +598,12 @@ namespace mz {
              * @brief Reads values into a span with endian conversion
              *
              * @tparam T Type of the values (must support endian swapping and be non-const)
-             * @tparam N Size of the span (deduced from the parameter)
+             * @tparam Extent Size of the span (deduced from the parameter)
              * @param SP Span where values will be stored
              * @return true if an error occurred, false on success
              */
-            template <mz::endian::SwapTypeNonConst T, size_t N>
-            bool readEndian(std::span<T, N> SP) const noexcept requires (READER)
+            template <mz::endian::SwapTypeNonConst T, size_t Extent>
+            bool readEndian(std::span<T, Extent> SP) const noexcept requires (READER)
             {
                 return readEndian(SP.data(), SP.size());
             }
@@ -609,13 +725,13 @@ namespace mz {
              *
              * @tparam T Type of the values (must be trivially copyable)
              * @param P Pointer to the array of values
-             * @param N Number of values to write
+             * @param Count Number of values to write
              * @return true if an error occurred, false on success
              */
             template <mz::endian::TrivialType T>
-            bool write(T const* P, size_t N) noexcept requires (WRITER)
+            bool write(T const* P, size_t Count) noexcept requires (WRITER)
             {
-                return write((void const*)P, sizeof(T) * N);
+                return write((void const*)P, sizeof(T) * Count);
             }
 
             /**
@@ -623,21 +739,21 @@ namespace mz {
              *
              * @tparam T Type of the values (must support endian swapping)
              * @param P Pointer to the array of values
-             * @param N Number of values to write
+             * @param Count Number of values to write
              * @return true if an error occurred, false on success
              */
             template <mz::endian::SwapType T>
-            bool writeEndian(T const* P, size_t N) noexcept requires (WRITER)
+            bool writeEndian(T const* P, size_t Count) noexcept requires (WRITER)
             {
                 if constexpr (mz::endian::endian_mismatch)
                 {
                     // Write and convert each value individually when endianness differs
-                    for (size_t i = 0; i < N && good(); i++) { writeEndian(P[i]); }
+                    for (size_t i = 0; i < Count && good(); i++) { writeEndian(P[i]); }
                     return fail();
                 }
                 else {
                     // No conversion needed if endianness matches
-                    return write(P, N);
+                    return write(P, Count);
                 }
             }
 
@@ -645,12 +761,12 @@ namespace mz {
              * @brief Writes a span of values to the file
              *
              * @tparam T Type of the values (must be trivially copyable)
-             * @tparam N Size of the span (deduced from the parameter)
+             * @tparam Extent Size of the span (deduced from the parameter)
              * @param SP Span of values to write
              * @return true if an error occurred, false on success
              */
-            template <mz::endian::TrivialType T, size_t N>
-            bool write(std::span<T, N> SP) noexcept requires (WRITER)
+            template <mz::endian::TrivialType T, size_t Extent>
+            bool write(std::span<T, Extent> SP) noexcept requires (WRITER)
             {
                 return write(SP.data(), SP.size());
             }
@@ -659,12 +775,12 @@ namespace mz {
              * @brief Writes a span of values with endian conversion
              *
              * @tparam T Type of the values (must support endian swapping)
-             * @tparam N Size of the span (deduced from the parameter)
+             * @tparam Extent Size of the span (deduced from the parameter)
              * @param SP Span of values to write
              * @return true if an error occurred, false on success
              */
-            template <mz::endian::SwapType T, size_t N>
-            bool writeEndian(std::span<T, N> SP) noexcept requires (WRITER)
+            template <mz::endian::SwapType T, size_t Extent>
+            bool writeEndian(std::span<T, Extent> SP) noexcept requires (WRITER)
             {
                 return writeEndian(SP.data(), SP.size());
             }
@@ -791,6 +907,7 @@ namespace mz {
                 }
                 else {
                     auto err = os_open(Path.string().c_str(), Flags);
+                    f_append = (Flags & O_APPEND) != 0;
 
                     e_flags.fill_open_errors(err);
                     if (f_handle == -1) {
@@ -798,7 +915,7 @@ namespace mz {
                     }
                     else if (err) {
                         e_flags.open = 1;
-                        _close(f_handle);
+                        os_close();
                         f_handle = -1;
                     }
                 }
@@ -807,6 +924,7 @@ namespace mz {
 
         private:
             int f_handle{ -1 };         ///< Platform-specific file handle
+            bool f_append{ false };     ///< Opened with O_APPEND
             mutable error_flags e_flags; ///< Error status flags
 
             //
@@ -829,34 +947,135 @@ namespace mz {
 
             int os_read(void* _Buf, unsigned Size) const noexcept { return _read(f_handle, _Buf, Size); }
             int os_write(void const* _Buf, unsigned Size) const noexcept { return _write(f_handle, _Buf, Size); }
+            int os_datasync() noexcept { return _commit(f_handle); }
+
+            int os_writev(std::span<std::string const> Bufs) noexcept {
+                // The CRT has no gather write: stage everything and write once
+                thread_local std::string staging;
+                try {
+                    staging.clear();
+                    for (auto const& S : Bufs) { staging += S; }
+                }
+                catch (...) {
+                    return -1;
+                }
+                size_t done = 0;
+                while (done < staging.size()) {
+                    int res = _write(f_handle, staging.data() + done, unsigned(staging.size() - done));
+                    if (res <= 0) { return -1; }
+                    done += size_t(res);
+                }
+                return 0;
+            }
+
+            int os_pwrite(void const* _Buf, size_t Size, long long Offset) const noexcept {
+                // The CRT has no positional write: serialize seek + write and restore the position
+                static std::mutex lock;
+                std::lock_guard<std::mutex> guard(lock);
+                long long saved = _telli64(f_handle);
+                if (saved == -1 || _lseeki64(f_handle, Offset, SEEK_SET) == -1) { return -1; }
+                int result = 0;
+                auto p = static_cast<char const*>(_Buf);
+                while (Size) {
+                    unsigned chunk = unsigned(Size < (1u << 30) ? Size : (1u << 30));
+                    int res = _write(f_handle, p, chunk);
+                    if (res <= 0) { result = -1; break; }
+                    p += res;
+                    Size -= size_t(res);
+                }
+                if (_lseeki64(f_handle, saved, SEEK_SET) == -1) { result = -1; }
+                return result;
+            }
 
 #else
     // POSIX implementations
-            long long os_tell() const noexcept { return lseek64(f_handle, 0, SEEK_CUR); }
-            long long os_seek(long long Offset, int Origin) const noexcept { return lseek64(f_handle, Offset, Origin); }
+            long long os_tell() const noexcept { return ::lseek(f_handle, 0, SEEK_CUR); }
+            long long os_seek(long long Offset, int Origin) const noexcept { return ::lseek(f_handle, off_t(Offset), Origin); }
 
-            int os_chsize(long long Size) noexcept { return ftruncate(f_handle, Size); }
-            int os_commit() noexcept { return fsync(f_handle); }
-            int os_close() noexcept { return close(f_handle); }
+            // Errors are returned as errno values, matching _chsize_s and _sopen_s
+            int os_chsize(long long Size) noexcept { return ::ftruncate(f_handle, off_t(Size)) ? errno : 0; }
+            int os_commit() noexcept { return ::fsync(f_handle); }
+            int os_close() noexcept { return ::close(f_handle); }
             int os_open(std::filesystem::path const& Path, int OperationFlags) noexcept {
-                return open(&f_handle, Path.string().c_str(), OperationFlags);
+                f_handle = ::open(Path.c_str(), OperationFlags, 0666);
+                return f_handle == -1 ? errno : 0;
+            }
+
+            int os_read(void* _Buf, unsigned Size) const noexcept { return int(::read(f_handle, _Buf, Size)); }
+            int os_write(void const* _Buf, unsigned Size) const noexcept { return int(::write(f_handle, _Buf, Size)); }
+
+#if defined(__linux__)
+            int os_datasync() noexcept { return ::fdatasync(f_handle); }
+#else
+            int os_datasync() noexcept { return ::fsync(f_handle); }
+#endif
+
+            int os_writev(std::span<std::string const> Bufs) noexcept {
+                constexpr size_t MaxVec{ IOV_MAX < 1024 ? IOV_MAX : 1024 };
+                iovec vec[MaxVec];
+
+                size_t next = 0;        // first string not yet handed to the kernel
+                size_t skip = 0;        // bytes of Bufs[next] already written
+                while (next < Bufs.size()) {
+                    int count = 0;
+                    size_t total = 0;
+                    for (size_t i = next; i < Bufs.size() && count < int(MaxVec); ++i) {
+                        size_t offset = (i == next) ? skip : 0;
+                        if (Bufs[i].size() == offset) continue;
+                        vec[count].iov_base = const_cast<char*>(Bufs[i].data() + offset);
+                        vec[count].iov_len = Bufs[i].size() - offset;
+                        total += vec[count].iov_len;
+                        ++count;
+                    }
+                    if (count == 0) { return 0; }
+
+                    ssize_t res = ::writev(f_handle, vec, count);
+                    if (res < 0) {
+                        if (errno == EINTR) continue;
+                        return -1;
+                    }
+                    if (res == 0) { return -1; }
+
+                    // Advance past everything the kernel accepted, resuming mid-string on short writes
+                    size_t left = size_t(res);
+                    while (next < Bufs.size() && left >= Bufs[next].size() - skip) {
+                        left -= Bufs[next].size() - skip;
+                        skip = 0;
+                        ++next;
+                    }
+                    skip += left;
+                }
+                return 0;
             }
 
-            int os_read(void* _Buf, unsigned Size) const noexcept { return read(f_handle, _Buf, Size); }
-            int os_write(void const* _Buf, unsigned Size) const noexcept { return write(f_handle, _Buf, Size); }
+            int os_pwrite(void const* _Buf, size_t Size, long long Offset) const noexcept {
+                auto p = static_cast<char const*>(_Buf);
+                while (Size) {
+                    ssize_t res = ::pwrite(f_handle, p, Size, off_t(Offset));
+                    if (res < 0) {
+                        if (errno == EINTR) continue;
+                        return -1;
+                    }
+                    if (res == 0) { return -1; }
+                    p += res;
+                    Size -= size_t(res);
+                    Offset += res;
+                }
+                return 0;
+            }
 
             long long os_size() const noexcept {
                 struct stat buf;
-                if (fstat(fd, &buf)) return -1;
+                if (::fstat(f_handle, &buf)) return -1;
                 return buf.st_size;
             }
 
             int os_eof() const noexcept {
                 uint8_t dummy;
-                ssize_t bytes_read = read(fd, &dummy, 1);
+                ssize_t bytes_read = ::read(f_handle, &dummy, 1);
                 if (bytes_read == 0) { return 1; }
                 if (bytes_read == -1) { return -1; }
-                if (lseek64(fd, -1, SEEK_CUR) == -1) { return -1; }
+                if (::lseek(f_handle, -1, SEEK_CUR) == -1) { return -1; }
                 return 0;
             }
 #endif
@@ -904,7 +1123,7 @@ namespace mz {
              * @return Modified flags that ensure read-only access
              */
             static constexpr int filter_open(int flags) noexcept {
-                return (flags | O_RDONLY) & ~(O_RDWR | _O_TRUNC | O_WRONLY | _O_APPEND | O_CREAT | O_EXCL);
+                return (flags | O_RDONLY) & ~(O_RDWR | O_TRUNC | O_WRONLY | O_APPEND | O_CREAT | O_EXCL);
             }
         };
 
@@ -1060,7 +1279,7 @@ namespace mz {
              * @return Modified flags that ensure read-write access
              */
             static constexpr int filter_open(int flags) noexcept {
-                return (flags | O_RDWR) & ~(_O_RDONLY | O_WRONLY & O_CREAT & O_EXCL);
+                return (flags | O_RDWR) & ~(O_RDONLY | O_WRONLY | O_CREAT | O_EXCL);
             }
 
             /**
@@ -1070,7 +1289,7 @@ namespace mz {
              * @return Modified flags for exclusive creation with read-write access
              */
             static constexpr int filter_excl(int flags) noexcept {
-                return (flags | O_RDWR | O_CREAT | O_EXCL) & ~(_O_RDONLY | O_WRONLY);
+                return (flags | O_RDWR | O_CREAT | O_EXCL) & ~(O_RDONLY | O_WRONLY);
             }
 
             /**
@@ -1080,7 +1299,7 @@ namespace mz {
              * @return Modified flags for creation with read-write access
              */
             static constexpr int filter_create(int flags) noexcept {
-                return (flags | O_RDWR | O_CREAT) & ~(_O_RDONLY | O_WRONLY & O_EXCL);
+                return (flags | O_RDWR | O_CREAT) & ~(O_RDONLY | O_WRONLY | O_EXCL);
             }
         };
     }
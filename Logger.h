@@ -26,16 +26,25 @@ SOFTWARE.
 #define MZ_LOGGER_HEADER_FILE
 #pragma once
 
+#include <algorithm>
 #include <string>
 #include <string_view>
 #include <format>
 #include <chrono>
-#include <fstream>
+#include <ios>
 #include <filesystem>
 #include <vector>
+#include <map>
+#include <queue>
+#include <functional>
+#include <memory>
+#include <atomic>
 #include <mutex>
 #include <optional>
 
+#include "FileIO.h"
+#include "MappedLogFile.h"
+
 namespace mz {
 
     /**
@@ -49,17 +58,73 @@ namespace mz {
         Critical  ///< Very severe error events that will likely lead to application failure
     };
 
+    /**
+     * @brief Durability applied after each buffer flush
+     */
+    enum class LogSync {
+        None,     ///< Leave flushed data in the OS page cache
+        Data,     ///< fdatasync after each flush: content and size are durable
+        Full      ///< fsync after each flush: content and all metadata are durable
+    };
+
+    template <bool ThreadSafe>
+    class Logger;
+
+    /**
+     * @brief A named subsystem with its own minimum log level
+     *
+     * Categories form a hierarchy through dotted names: "net.http" inherits from
+     * "net", which inherits from the logger's global level. Inheritance is resolved
+     * whenever a level changes, so the check on the logging path is one atomic load.
+     * Obtain categories from Logger::category(); references stay valid for the
+     * lifetime of the logger that created them.
+     */
+    class LogCategory {
+    public:
+        /**
+         * @brief Full dotted name of the category
+         * @return Category name
+         */
+        std::string_view name() const noexcept { return m_name; }
+
+        /**
+         * @brief Effective minimum level after inheritance
+         * @return Current resolved level
+         */
+        LogLevel level() const noexcept { return m_level.load(std::memory_order_relaxed); }
+
+        /**
+         * @brief Check if a message with the specified level should be logged
+         * @param level The level to check
+         * @return True if the message should be logged
+         */
+        bool enabled(LogLevel level) const noexcept { return level >= m_level.load(std::memory_order_relaxed); }
+
+        explicit LogCategory(std::string name) noexcept : m_name{ std::move(name) } {}
+
+    private:
+        template <bool> friend class Logger;
+
+        std::string m_name;                              ///< Dotted category name
+        std::atomic<LogLevel> m_level{ LogLevel::Info }; ///< Resolved level read on every call
+        std::optional<LogLevel> m_explicit;              ///< Level set on this category itself, guarded by the logger
+    };
+
     /**
      * @brief A thread-safe, buffered logging utility with configurable options
      *
-     * @tparam ThreadSafe If true, logging operations are protected by a mutex for thread safety
+     * @tparam ThreadSafe If true, each thread stages messages in its own buffer and a
+     *                    collector merges them in sequence order at flush time.
      *                    If false, no synchronization is used (faster but not thread-safe)
      *
      * This class provides a flexible logging system with support for:
      * - Multiple log levels
+     * - Hierarchical per-category levels
      * - Timestamped messages
      * - File rotation based on size
-     * - Message buffering for performance
+     * - Message buffering with one gather write per flush
+     * - Optional memory-mapped output with lock-free appends (startMapped)
+     * - Optional fdatasync/fsync after each flush
      * - Optional thread safety
      * - Custom headers and indentation
      * - Formatted logging with std::format support
@@ -68,39 +133,94 @@ namespace mz {
     class Logger {
     private:
         // ---- Core members ----
-        std::ofstream m_fileStream{};                 ///< Output file stream
+        mz::io::FileWO m_file{};                      ///< Output file handle
+        uint64_t m_fileSize{ 0 };                     ///< Bytes in the active log file
         std::string m_header{};                       ///< Custom header or indentation prefix
-        std::vector<std::string> m_buffer;            ///< Message buffer to reduce I/O
+        std::vector<std::string> m_buffer;            ///< Message buffer to reduce I/O (collector side when ThreadSafe)
         std::optional<std::filesystem::path> m_path;  ///< Current log file path
-        LogLevel m_currentLevel{ LogLevel::Info };      ///< Minimum log level to output
+        std::atomic<LogLevel> m_currentLevel{ LogLevel::Info }; ///< Minimum log level to output
+        std::atomic<bool> m_active{ false };          ///< True while a log file is open
 
         // ---- Configuration options ----
-        size_t m_bufferSize{ 1024 };                    ///< Maximum buffer size before flush
+        std::atomic<size_t> m_bufferSize{ 1024 };       ///< Maximum buffered messages (per thread when ThreadSafe) before flush
         size_t m_maxFileSize{ 10 * 1024 * 1024 };       ///< Maximum log file size (10MB default)
         int m_maxRotationCount{ 5 };                    ///< Maximum number of rotated log files
+        LogSync m_sync{ LogSync::None };                ///< Durability applied after each flush
 
         // ---- Error tracking ----
         enum class ErrorState {
             None,
             FileOpenError,
             WriteError,
+            SyncError,
             FormatError,
             RotationError
         };
         ErrorState m_lastError{ ErrorState::None };     ///< Last error that occurred
         std::string m_errorMessage{};                 ///< Error message for the last error
 
+        // ---- Per-thread staging (ThreadSafe only) ----
+        /**
+         * @brief A formatted message tagged with its position in the global order
+         */
+        struct StagedMessage {
+            uint64_t seq;
+            std::string text;
+        };
+
+        /**
+         * @brief Messages staged by one thread for one logger
+         *
+         * The lock is only ever taken by the owning thread and by the collector
+         * while it drains the buffer, so producers never contend with each other.
+         */
+        struct ThreadBuffer {
+            std::mutex lock;
+            std::vector<StagedMessage> messages;
+            std::atomic<bool> orphaned{ false };     ///< Owning thread has exited
+        };
+
+        /**
+         * @brief Per-thread cache of the buffers a thread owns, keyed by logger id
+         *
+         * Marks its buffers orphaned at thread exit so the collector can drop them
+         * once drained. Shared ownership keeps this safe whichever of the thread
+         * or the logger goes away first.
+         */
+        struct ThreadBufferCache {
+            std::vector<std::pair<uint64_t, std::shared_ptr<ThreadBuffer>>> entries;
+            ~ThreadBufferCache() {
+                for (auto& entry : entries) {
+                    entry.second->orphaned.store(true, std::memory_order_release);
+                }
+            }
+        };
+
+        inline static std::atomic<uint64_t> s_nextId{ 0 };
+        const uint64_t m_id{ s_nextId.fetch_add(1, std::memory_order_relaxed) }; ///< Key into each thread's cache
+        std::atomic<uint64_t> m_sequence{ 0 };                       ///< Global message order
+        std::vector<std::shared_ptr<ThreadBuffer>> m_threadBuffers;  ///< Every registered buffer, guarded by m_mutex
+        std::vector<std::vector<StagedMessage>> m_runs;              ///< Drained per-thread runs awaiting merge
+        std::vector<size_t> m_orphans;                               ///< Indices of drained buffers whose thread has exited
+
+        // ---- Memory-mapped output ----
+        std::atomic<mz::io::MappedLogFile*> m_mappedSink{ nullptr };      ///< Active mapped file, if any
+        std::vector<std::unique_ptr<mz::io::MappedLogFile>> m_mappedFiles; ///< Every mapped file opened, kept alive for stale producers
+
+        // ---- Categories ----
+        std::map<std::string, std::unique_ptr<LogCategory>, std::less<>> m_categories; ///< Registered categories, guarded by m_mutex
+
         // ---- Thread synchronization ----
         /**
-         * @brief Mutex for thread-safe operations, only used when ThreadSafe is true
+         * @brief Mutex for configuration and the flush path, only used when ThreadSafe is true
          */
-        std::mutex m_mutex;
+        mutable std::mutex m_mutex;
 
         /**
          * @brief Helper template for conditionally acquiring a lock based on ThreadSafe
          */
         template <typename Func>
-        auto withLock(Func&& func) -> decltype(func()) {
+        auto withLock(Func&& func) const -> decltype(func()) {
             if constexpr (ThreadSafe) {
                 std::lock_guard<std::mutex> lock(m_mutex);
                 return func();
@@ -126,6 +246,34 @@ namespace mz {
             }
         }
 
+        /**
+         * @brief Translate std::ios open mode bits into FileWO open flags
+         * @param mode std::ios::app to append, anything else truncates
+         * @return Flags for FileWO::create
+         */
+        static constexpr int openFlags(int mode) noexcept {
+            int flags = (mode & std::ios::app) ? O_APPEND : O_TRUNC;
+#ifdef _MSC_VER
+            flags |= _O_BINARY;
+#endif
+            return flags;
+        }
+
+        /**
+         * @brief Open the log file and record its current size
+         * @param path Path to the log file
+         * @param flags FileWO open flags
+         * @return True if the file was opened
+         */
+        bool openFile(const std::filesystem::path& path, int flags) noexcept {
+            if (!m_file.create(path, flags)) {
+                return false;
+            }
+            auto length = m_file.length();
+            m_fileSize = length > 0 ? uint64_t(length) : 0;
+            return true;
+        }
+
         /**
          * @brief Rotate log files when the current log file reaches max size
          *
@@ -136,7 +284,7 @@ namespace mz {
 
             try {
                 // Close current file
-                m_fileStream.close();
+                m_file.close();
 
                 // Perform rotation
                 auto base = m_path->string();
@@ -158,8 +306,7 @@ namespace mz {
                 std::filesystem::rename(base, std::format("{}.1", base));
 
                 // Open a new log file
-                m_fileStream.open(base, std::ios::out | std::ios::binary);
-                if (!m_fileStream.is_open()) {
+                if (!openFile(*m_path, openFlags(std::ios::trunc))) {
                     m_lastError = ErrorState::FileOpenError;
                     m_errorMessage = "Failed to open new log file after rotation";
                 }
@@ -169,8 +316,8 @@ namespace mz {
                 m_errorMessage = std::format("Log rotation failed: {}", ex.what());
 
                 // Attempt to reopen the original file
-                if (!m_fileStream.is_open() && m_path) {
-                    m_fileStream.open(m_path->string(), std::ios::out | std::ios::binary | std::ios::app);
+                if (!m_file.is_open() && m_path) {
+                    openFile(*m_path, openFlags(std::ios::app));
                 }
             }
         }
@@ -179,43 +326,302 @@ namespace mz {
          * @brief Check if log rotation is needed and perform rotation if required
          */
         void checkRotation() noexcept {
-            if (!m_path || !m_fileStream.is_open()) return;
+            if (!m_path || !m_file.is_open()) return;
 
-            try {
-                auto size = std::filesystem::file_size(*m_path);
-                if (size > m_maxFileSize) {
-                    rotateLogFiles();
-                }
-            }
-            catch (...) {
-                // Silently ignore file size check errors
+            // The size is tracked from our own writes, so no stat() per check
+            if (m_fileSize > m_maxFileSize) {
+                rotateLogFiles();
             }
         }
 
         /**
          * @brief Write accumulated messages from buffer to the file
+         *
+         * The whole buffer goes out in one gather write, followed by the
+         * configured sync tier. The buffer is emptied either way: after a
+         * failed write some of it may already be in the file, so a retry
+         * could duplicate lines, and keeping it would grow without bound
+         * while the failure persists. A failed sync does not drop anything,
+         * as the data was written; it is reported as SyncError.
+         *
          * @return True if successful, false otherwise
          */
         bool flushBuffer() noexcept {
-            if (!m_fileStream.is_open() || m_buffer.empty()) {
+            if constexpr (ThreadSafe) {
+                collectThreadBuffers();
+            }
+
+            if (m_buffer.empty()) {
                 return true; // Nothing to do
             }
+            if (!m_file.is_open()) {
+                m_buffer.clear(); // No destination, e.g. after a failed rotation
+                return true;
+            }
+
+            uint64_t bytes = 0;
+            for (const auto& msg : m_buffer) {
+                bytes += msg.size();
+            }
+
+            const bool writeFailed = m_file.writev(m_buffer);
+            m_buffer.clear();
+            if (writeFailed) {
+                // Only fail bits are set, so the next flush can try again
+                m_file.clear();
+                m_lastError = ErrorState::WriteError;
+                m_errorMessage = "Failed to flush buffer; buffered messages were dropped";
+                return false;
+            }
+            m_fileSize += bytes;
+
+            bool syncFailed = false;
+            if (m_sync == LogSync::Data) {
+                syncFailed = m_file.datasync();
+            }
+            else if (m_sync == LogSync::Full) {
+                syncFailed = m_file.commit();
+            }
+            if (syncFailed) {
+                m_file.clear();
+                m_lastError = ErrorState::SyncError;
+                m_errorMessage = "Failed to sync log file";
+                return false;
+            }
+            return true;
+        }
+
+        /**
+         * @brief Find or register the calling thread's staging buffer
+         * @return Buffer owned by the calling thread for this logger
+         */
+        ThreadBuffer& localBuffer() {
+            thread_local ThreadBufferCache cache;
+            for (auto& entry : cache.entries) {
+                if (entry.first == m_id) {
+                    return *entry.second;
+                }
+            }
 
+            // First message from this thread: register under the collector lock
+            auto buffer = std::make_shared<ThreadBuffer>();
+            buffer->messages.reserve(m_bufferSize.load(std::memory_order_relaxed));
+            withLock([this, &buffer]() {
+                m_threadBuffers.push_back(buffer);
+                });
+            cache.entries.emplace_back(m_id, buffer);
+            return *buffer;
+        }
+
+        /**
+         * @brief Drain all thread buffers and merge them into m_buffer in sequence order
+         *
+         * Every buffer lock is held while draining. Sequence numbers are taken under
+         * those locks, so the drained messages are exactly those numbered below some
+         * cut and a later flush never emits a smaller number than this one did.
+         * Each thread's run is already sorted, so a k-way merge over the run heads
+         * restores the global order. Caller must hold m_mutex.
+         */
+        void collectThreadBuffers() noexcept {
             try {
-                for (const auto& msg : m_buffer) {
-                    m_fileStream << msg;
+                size_t live = 0;
+                m_runs.resize(std::max(m_runs.size(), m_threadBuffers.size()));
+                m_orphans.clear();
+                {
+                    // Producers only ever hold their own lock, so taking all of them cannot deadlock
+                    std::vector<std::unique_lock<std::mutex>> locks;
+                    locks.reserve(m_threadBuffers.size());
+                    for (auto& buffer : m_threadBuffers) {
+                        locks.emplace_back(buffer->lock);
+                    }
+                    // Swap each run out; the thread keeps the capacity of the run it gets back
+                    for (size_t i = 0; i < m_threadBuffers.size(); ++i) {
+                        auto& buffer = *m_threadBuffers[i];
+                        m_runs[live].clear();
+                        buffer.messages.swap(m_runs[live]);
+                        if (!m_runs[live].empty()) {
+                            ++live;
+                        }
+                        // The owner is gone and will never append again
+                        if (buffer.orphaned.load(std::memory_order_acquire)) {
+                            m_orphans.push_back(i);
+                        }
+                    }
+                }
+                for (size_t k = m_orphans.size(); k-- > 0;) {
+                    m_threadBuffers[m_orphans[k]] = std::move(m_threadBuffers.back());
+                    m_threadBuffers.pop_back();
+                }
+
+                if (live == 1) {
+                    for (auto& msg : m_runs[0]) {
+                        m_buffer.push_back(std::move(msg.text));
+                    }
+                }
+                else if (live > 1) {
+                    using Head = std::pair<uint64_t, size_t>; // sequence, run index
+                    std::priority_queue<Head, std::vector<Head>, std::greater<Head>> heads;
+                    std::vector<size_t> position(live, 0);
+                    for (size_t r = 0; r < live; ++r) {
+                        heads.emplace(m_runs[r].front().seq, r);
+                    }
+                    while (!heads.empty()) {
+                        size_t r = heads.top().second;
+                        heads.pop();
+                        m_buffer.push_back(std::move(m_runs[r][position[r]].text));
+                        if (++position[r] < m_runs[r].size()) {
+                            heads.emplace(m_runs[r][position[r]].seq, r);
+                        }
+                    }
                 }
-                m_fileStream.flush();
-                m_buffer.clear();
-                return true;
             }
             catch (const std::exception& ex) {
                 m_lastError = ErrorState::WriteError;
-                m_errorMessage = std::format("Failed to flush buffer: {}", ex.what());
-                return false;
+                m_errorMessage = std::format("Failed to collect thread buffers: {}", ex.what());
+            }
+        }
+
+        /**
+         * @brief Queue a finished line for output
+         *
+         * With a mapped file the line is appended to it directly. Otherwise, with
+         * ThreadSafe the line lands in the calling thread's own buffer and only
+         * a full buffer takes the collector lock to flush. Without it the line goes
+         * straight into m_buffer.
+         *
+         * @param text Fully formatted line
+         */
+        void stage(std::string&& text) {
+            // Mapped output: reserve and copy straight into the file, no buffering at all
+            if (auto* sink = m_mappedSink.load(std::memory_order_acquire)) {
+                if (sink->write(text)) {
+                    withLock([this]() {
+                        m_lastError = ErrorState::WriteError;
+                        m_errorMessage = "Failed to append to mapped log file";
+                        });
+                }
+                return;
+            }
+
+            if constexpr (ThreadSafe) {
+                auto& buffer = localBuffer();
+                size_t pending;
+                {
+                    std::lock_guard<std::mutex> lock(buffer.lock);
+                    buffer.messages.push_back({ m_sequence.fetch_add(1, std::memory_order_relaxed), std::move(text) });
+                    pending = buffer.messages.size();
+                }
+                if (pending >= m_bufferSize.load(std::memory_order_relaxed)) {
+                    withLock([this]() {
+                        flushBuffer();
+                        checkRotation();
+                        });
+                }
+            }
+            else {
+                // If buffer would exceed size, flush it first
+                if (m_buffer.size() >= m_bufferSize) {
+                    flushBuffer();
+                    checkRotation();
+                }
+                m_buffer.push_back(std::move(text));
+            }
+        }
+
+        /**
+         * @brief Resolve the level a category inherits
+         *
+         * Walks up the dotted name to the nearest ancestor with an explicit level,
+         * falling back to the global level. Caller must hold m_mutex.
+         *
+         * @param category Category to resolve
+         * @return Effective level for the category
+         */
+        LogLevel resolveLevel(const LogCategory& category) const noexcept {
+            if (category.m_explicit) {
+                return *category.m_explicit;
+            }
+            std::string_view name{ category.m_name };
+            for (auto dot = name.rfind('.'); dot != std::string_view::npos; dot = name.rfind('.')) {
+                name = name.substr(0, dot);
+                auto it = m_categories.find(name);
+                if (it != m_categories.end() && it->second->m_explicit) {
+                    return *it->second->m_explicit;
+                }
+            }
+            return m_currentLevel.load(std::memory_order_relaxed);
+        }
+
+        /**
+         * @brief Re-resolve a category and all of its descendants
+         * @param name Root of the subtree; empty re-resolves every category
+         */
+        void resolveSubtree(std::string_view name) noexcept {
+            // Map order places descendants ("a.b", "a.c.d") right after their root "a"
+            for (auto it = m_categories.lower_bound(name); it != m_categories.end(); ++it) {
+                std::string_view key{ it->first };
+                if (key.substr(0, name.size()) != name) break;
+                if (key.size() > name.size() && !name.empty() && key[name.size()] != '.') continue;
+                it->second->m_level.store(resolveLevel(*it->second), std::memory_order_relaxed);
+            }
+        }
+
+        /**
+         * @brief Find or register a category; caller must hold m_mutex
+         * @param name Dotted category name
+         * @return The registered category
+         */
+        LogCategory& findOrCreateCategory(std::string_view name) {
+            auto it = m_categories.find(name);
+            if (it == m_categories.end()) {
+                auto category = std::make_unique<LogCategory>(std::string(name));
+                category->m_level.store(resolveLevel(*category), std::memory_order_relaxed);
+                it = m_categories.emplace(std::string(name), std::move(category)).first;
+            }
+            return *it->second;
+        }
+
+        /**
+         * @brief Format and stage one leveled line
+         * @param level Log level for this message
+         * @param category Category name, empty for none
+         * @param msg Message text
+         */
+        void emit(LogLevel level, std::string_view category, std::string_view msg) noexcept {
+            try {
+                auto levelStr = logLevelToString(level);
+                auto now = std::chrono::system_clock::now();
+                std::string line = category.empty()
+                    ? std::format("\n{:%Y-%m-%d %H:%M:%S} [{}] ", now, levelStr)
+                    : std::format("\n{:%Y-%m-%d %H:%M:%S} [{}] [{}] ", now, levelStr, category);
+                line += m_header;
+                line += ": ";
+                line += msg;
+                stage(std::move(line));
+            }
+            catch (const std::exception& ex) {
+                recordError(ErrorState::FormatError, "Log formatting failed", ex);
             }
         }
 
+        /**
+         * @brief Record a failure raised on the producer path
+         * @param state Error category to record
+         * @param what Description prefix
+         * @param ex The exception that was caught
+         */
+        void recordError(ErrorState state, std::string_view what, const std::exception& ex) noexcept {
+            withLock([this, state, what, &ex]() {
+                try {
+                    m_lastError = state;
+                    m_errorMessage = std::format("{}: {}", what, ex.what());
+                }
+                catch (...) {
+                    m_errorMessage.clear();
+                }
+                });
+        }
+
     public:
         /**
          * @brief Default constructor
@@ -228,7 +634,7 @@ namespace mz {
          */
         explicit Logger(size_t indent) noexcept
             : m_header{ std::format("{:>{}}", "", indent) } {
-            m_buffer.reserve(m_bufferSize);
+            m_buffer.reserve(m_bufferSize.load(std::memory_order_relaxed));
         }
 
         /**
@@ -237,7 +643,7 @@ namespace mz {
          */
         explicit Logger(std::string header) noexcept
             : m_header{ std::move(header) } {
-            m_buffer.reserve(m_bufferSize);
+            m_buffer.reserve(m_bufferSize.load(std::memory_order_relaxed));
         }
 
         /**
@@ -246,8 +652,9 @@ namespace mz {
         ~Logger() noexcept {
             withLock([this]() {
                 flushBuffer();
-                if (m_fileStream.is_open()) {
-                    m_fileStream.close();
+                m_file.close();
+                if (auto* sink = m_mappedSink.exchange(nullptr)) {
+                    sink->close();
                 }
                 });
         }
@@ -261,7 +668,7 @@ namespace mz {
         int start(const std::filesystem::path& path, int mode = std::ios::app) noexcept {
             return withLock([this, &path, mode]() {
                 // Return if already open
-                if (m_fileStream.is_open()) {
+                if (m_file.is_open() || m_mappedSink.load()) {
                     return 1;
                 }
 
@@ -273,9 +680,9 @@ namespace mz {
                     }
 
                     // Open the file
-                    m_fileStream.open(path.string(), std::ios::out | std::ios::binary | mode);
-                    if (m_fileStream.is_open()) {
+                    if (openFile(path, openFlags(mode))) {
                         m_path = path;
+                        m_active.store(true, std::memory_order_release);
                         m_lastError = ErrorState::None;
                         m_errorMessage.clear();
                         return 0;
@@ -294,14 +701,68 @@ namespace mz {
                 });
         }
 
+        /**
+         * @brief Open or create a memory-mapped log file
+         *
+         * Producers format on their own thread and copy each line straight into
+         * the mapping, reserving space with one atomic add. There is no
+         * buffering, no system call and no shared lock per message. Size-based
+         * rotation does not apply to mapped files. flush() msyncs the mapping
+         * when a sync tier other than LogSync::None is set.
+         *
+         * @param path Path to the log file
+         * @param segmentSize Bytes mapped at a time
+         * @param mode File open mode (append by default)
+         * @return 0 on success, 1 if already open, -1 on error
+         */
+        int startMapped(const std::filesystem::path& path,
+            size_t segmentSize = mz::io::MappedLogFile::DefaultSegmentSize,
+            int mode = std::ios::app) noexcept {
+            return withLock([this, &path, segmentSize, mode]() {
+                // Return if already open
+                if (m_file.is_open() || m_mappedSink.load()) {
+                    return 1;
+                }
+
+                try {
+                    // Create directory if it doesn't exist
+                    auto directory = path.parent_path();
+                    if (!directory.empty() && !std::filesystem::exists(directory)) {
+                        std::filesystem::create_directories(directory);
+                    }
+
+                    auto sink = std::make_unique<mz::io::MappedLogFile>(segmentSize);
+                    if (!sink->open(path, (mode & std::ios::app) != 0)) {
+                        m_lastError = ErrorState::FileOpenError;
+                        m_errorMessage = "Failed to map log file";
+                        return -1;
+                    }
+                    m_path = path;
+                    m_mappedSink.store(sink.get(), std::memory_order_release);
+                    m_mappedFiles.push_back(std::move(sink));
+                    m_active.store(true, std::memory_order_release);
+                    m_lastError = ErrorState::None;
+                    m_errorMessage.clear();
+                    return 0;
+                }
+                catch (const std::exception& ex) {
+                    m_lastError = ErrorState::FileOpenError;
+                    m_errorMessage = std::format("Exception mapping log file: {}", ex.what());
+                    return -1;
+                }
+                });
+        }
+
         /**
          * @brief Close the log file
          */
         void close() noexcept {
             withLock([this]() {
+                m_active.store(false, std::memory_order_release);
                 flushBuffer();
-                if (m_fileStream.is_open()) {
-                    m_fileStream.close();
+                m_file.close();
+                if (auto* sink = m_mappedSink.exchange(nullptr)) {
+                    sink->close();
                 }
                 });
         }
@@ -312,7 +773,8 @@ namespace mz {
          */
         void setLevel(LogLevel level) noexcept {
             withLock([this, level]() {
-                m_currentLevel = level;
+                m_currentLevel.store(level, std::memory_order_relaxed);
+                resolveSubtree({});
                 });
         }
 
@@ -321,9 +783,7 @@ namespace mz {
          * @return Current log level
          */
         LogLevel getLevel() const noexcept {
-            return withLock([this]() {
-                return m_currentLevel;
-                });
+            return m_currentLevel.load(std::memory_order_relaxed);
         }
 
         /**
@@ -332,8 +792,47 @@ namespace mz {
          * @return True if the message should be logged
          */
         bool shouldLog(LogLevel level) const noexcept {
-            return withLock([this, level]() {
-                return level >= m_currentLevel;
+            return level >= m_currentLevel.load(std::memory_order_relaxed);
+        }
+
+        /**
+         * @brief Get or register a named category
+         *
+         * The category inherits its level from the nearest dotted ancestor with an
+         * explicit level, or from the global level.
+         *
+         * @param name Dotted category name, e.g. "net.http"
+         * @return Category handle, valid for the lifetime of this logger
+         */
+        LogCategory& category(std::string_view name) {
+            return withLock([this, name]() -> LogCategory& {
+                return findOrCreateCategory(name);
+                });
+        }
+
+        /**
+         * @brief Set an explicit level on a category and its non-overridden descendants
+         * @param name Dotted category name; registered if unknown
+         * @param level The minimum level to log for this subtree
+         */
+        void setCategoryLevel(std::string_view name, LogLevel level) {
+            withLock([this, name, level]() {
+                findOrCreateCategory(name).m_explicit = level;
+                resolveSubtree(name);
+                });
+        }
+
+        /**
+         * @brief Remove a category's explicit level so it inherits again
+         * @param name Dotted category name
+         */
+        void clearCategoryLevel(std::string_view name) noexcept {
+            withLock([this, name]() {
+                auto it = m_categories.find(name);
+                if (it != m_categories.end()) {
+                    it->second->m_explicit.reset();
+                    resolveSubtree(name);
+                }
                 });
         }
 
@@ -343,11 +842,21 @@ namespace mz {
          */
         void setBufferSize(size_t size) noexcept {
             withLock([this, size]() {
-                m_bufferSize = size;
+                m_bufferSize.store(size, std::memory_order_relaxed);
                 m_buffer.reserve(size);
                 });
         }
 
+        /**
+         * @brief Set the durability applied after each buffer flush
+         * @param sync LogSync::None (default), LogSync::Data or LogSync::Full
+         */
+        void setSync(LogSync sync) noexcept {
+            withLock([this, sync]() {
+                m_sync = sync;
+                });
+        }
+
         /**
          * @brief Set the maximum log file size before rotation
          * @param size Maximum file size in bytes
@@ -404,6 +913,9 @@ namespace mz {
          */
         bool flush() noexcept {
             return withLock([this]() {
+                if (auto* sink = m_mappedSink.load()) {
+                    return m_sync == LogSync::None || !sink->sync();
+                }
                 return flushBuffer();
                 });
         }
@@ -413,25 +925,18 @@ namespace mz {
          * @return Reference to this logger for chaining
          */
         Logger& timestamp() noexcept {
-            return withLock([this]() -> Logger& {
-                try {
-                    auto now = std::chrono::system_clock::now();
-                    std::string timeStr = std::format("\n{:%Y-%m-%d %H:%M:%S} ", now);
-
-                    if (m_fileStream.is_open()) {
-                        // If buffer would exceed size, flush it first
-                        if (m_buffer.size() >= m_bufferSize) {
-                            flushBuffer();
-                        }
-                        m_buffer.push_back(timeStr + m_header);
-                    }
-                }
-                catch (const std::exception& ex) {
-                    m_lastError = ErrorState::FormatError;
-                    m_errorMessage = std::format("Timestamp formatting failed: {}", ex.what());
-                }
+            if (!m_active.load(std::memory_order_acquire)) {
                 return *this;
-                });
+            }
+
+            try {
+                auto now = std::chrono::system_clock::now();
+                stage(std::format("\n{:%Y-%m-%d %H:%M:%S} ", now) + m_header);
+            }
+            catch (const std::exception& ex) {
+                recordError(ErrorState::FormatError, "Timestamp formatting failed", ex);
+            }
+            return *this;
         }
 
         /**
@@ -440,25 +945,18 @@ namespace mz {
          * @return Reference to this logger for chaining
          */
         Logger& timestamp(std::string_view label) noexcept {
-            return withLock([this, label]() -> Logger& {
-                try {
-                    auto now = std::chrono::system_clock::now();
-                    std::string timeStr = std::format("\n{:%Y-%m-%d %H:%M:%S} ", now);
-
-                    if (m_fileStream.is_open()) {
-                        // If buffer would exceed size, flush it first
-                        if (m_buffer.size() >= m_bufferSize) {
-                            flushBuffer();
-                        }
-                        m_buffer.push_back(timeStr + m_header + ": " + std::string(label));
-                    }
-                }
-                catch (const std::exception& ex) {
-                    m_lastError = ErrorState::FormatError;
-                    m_errorMessage = std::format("Timestamp formatting failed: {}", ex.what());
-                }
+            if (!m_active.load(std::memory_order_acquire)) {
                 return *this;
-                });
+            }
+
+            try {
+                auto now = std::chrono::system_clock::now();
+                stage(std::format("\n{:%Y-%m-%d %H:%M:%S} ", now) + m_header + ": " + std::string(label));
+            }
+            catch (const std::exception& ex) {
+                recordError(ErrorState::FormatError, "Timestamp formatting failed", ex);
+            }
+            return *this;
         }
 
         /**
@@ -468,35 +966,35 @@ namespace mz {
          * @return Reference to this logger for chaining
          */
         Logger& log(LogLevel level, std::string_view msg) noexcept {
-            if (!shouldLog(level)) {
+            if (!shouldLog(level) || !m_active.load(std::memory_order_acquire)) {
                 return *this;
             }
 
-            return withLock([this, level, msg]() -> Logger& {
-                try {
-                    if (m_fileStream.is_open()) {
-                        auto levelStr = logLevelToString(level);
-                        auto now = std::chrono::system_clock::now();
-                        std::string timeStr = std::format("\n{:%Y-%m-%d %H:%M:%S} [{}] ", now, levelStr);
-
-                        // If buffer would exceed size, flush it first
-                        if (m_buffer.size() >= m_bufferSize) {
-                            flushBuffer();
-                            checkRotation();
-                        }
-                        m_buffer.push_back(timeStr + m_header + ": " + std::string(msg));
-                    }
-                }
-                catch (const std::exception& ex) {
-                    m_lastError = ErrorState::FormatError;
-                    m_errorMessage = std::format("Log formatting failed: {}", ex.what());
-                }
+            emit(level, {}, msg);
+            return *this;
+        }
+
+        /**
+         * @brief Log a message under a category
+         * @param category Category from category(); its resolved level gates the message
+         * @param level Log level for this message
+         * @param msg Message to log
+         * @return Reference to this logger for chaining
+         */
+        Logger& log(const LogCategory& category, LogLevel level, std::string_view msg) noexcept {
+            if (!category.enabled(level) || !m_active.load(std::memory_order_acquire)) {
                 return *this;
-                });
+            }
+
+            emit(level, category.name(), msg);
+            return *this;
         }
 
         /**
          * @brief Log a message with formatting
+         *
+         * Formatting happens on the calling thread before anything is staged.
+         *
          * @tparam Args Argument types for formatting
          * @param level Log level for this message
          * @param fmt Format string
@@ -505,32 +1003,41 @@ namespace mz {
          */
         template<typename... Args>
         Logger& logf(LogLevel level, std::string_view fmt, Args&&... args) noexcept {
-            if (!shouldLog(level)) {
+            if (!shouldLog(level) || !m_active.load(std::memory_order_acquire)) {
                 return *this;
             }
 
-            return withLock([this, level, fmt, ... args = std::forward<Args>(args)]() -> Logger& {
-                try {
-                    std::string formatted = std::format(fmt, std::forward<Args>(args)...);
-                    if (m_fileStream.is_open()) {
-                        auto levelStr = logLevelToString(level);
-                        auto now = std::chrono::system_clock::now();
-                        std::string timeStr = std::format("\n{:%Y-%m-%d %H:%M:%S} [{}] ", now, levelStr);
-
-                        // If buffer would exceed size, flush it first
-                        if (m_buffer.size() >= m_bufferSize) {
-                            flushBuffer();
-                            checkRotation();
-                        }
-                        m_buffer.push_back(timeStr + m_header + ": " + formatted);
-                    }
-                }
-                catch (const std::exception& ex) {
-                    m_lastError = ErrorState::FormatError;
-                    m_errorMessage = std::format("Log formatting failed: {}", ex.what());
-                }
+            try {
+                emit(level, {}, std::vformat(fmt, std::make_format_args(args...)));
+            }
+            catch (const std::exception& ex) {
+                recordError(ErrorState::FormatError, "Log formatting failed", ex);
+            }
+            return *this;
+        }
+
+        /**
+         * @brief Log a formatted message under a category
+         * @tparam Args Argument types for formatting
+         * @param category Category from category(); its resolved level gates the message
+         * @param level Log level for this message
+         * @param fmt Format string
+         * @param args Arguments for format string
+         * @return Reference to this logger for chaining
+         */
+        template<typename... Args>
+        Logger& logf(const LogCategory& category, LogLevel level, std::string_view fmt, Args&&... args) noexcept {
+            if (!category.enabled(level) || !m_active.load(std::memory_order_acquire)) {
                 return *this;
-                });
+            }
+
+            try {
+                emit(level, category.name(), std::vformat(fmt, std::make_format_args(args...)));
+            }
+            catch (const std::exception& ex) {
+                recordError(ErrorState::FormatError, "Log formatting failed", ex);
+            }
+            return *this;
         }
 
         /**
@@ -539,23 +1046,17 @@ namespace mz {
          * @return Reference to this logger for chaining
          */
         Logger& operator<<(std::string_view msg) noexcept {
-            return withLock([this, msg]() -> Logger& {
-                try {
-                    if (m_fileStream.is_open()) {
-                        // If buffer would exceed size, flush it first
-                        if (m_buffer.size() >= m_bufferSize) {
-                            flushBuffer();
-                            checkRotation();
-                        }
-                        m_buffer.push_back(std::string(msg));
-                    }
-                }
-                catch (const std::exception& ex) {
-                    m_lastError = ErrorState::WriteError;
-                    m_errorMessage = std::format("Write failed: {}", ex.what());
-                }
+            if (!m_active.load(std::memory_order_acquire)) {
                 return *this;
-                });
+            }
+
+            try {
+                stage(std::string(msg));
+            }
+            catch (const std::exception& ex) {
+                recordError(ErrorState::WriteError, "Write failed", ex);
+            }
+            return *this;
         }
 
         // Convenience logging methods for different levels
@@ -0,0 +1,429 @@
+/*
+* MIT License
+*
+* Copyright (c) 2025 Meysam Zare
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*/
+
+#ifndef IO_MAPPED_LOG_FILE_HEADER_FILE
+#define IO_MAPPED_LOG_FILE_HEADER_FILE
+#pragma once
+
+/**
+ * @file MappedLogFile.h
+ * @brief Multi-producer append-only file writer backed by a memory mapping
+ *
+ * MappedLogFile maps a fixed-size segment of the file at its current end.
+ * Producers reserve space with a single atomic fetch_add on the segment cursor
+ * and copy their bytes straight into the mapping; there is no system call and
+ * no shared lock on the append path. The kernel writes dirty pages back on its
+ * own schedule, and sync() forces them out when durability is needed.
+ *
+ * When a reservation crosses the end of the segment, the producer that owns the
+ * crossing reservation maps the next segment, finishes its write across the
+ * boundary and retires the old mapping once its in-flight writers are done.
+ * Producers whose reservation fell entirely past the end wait for the new
+ * segment and retry. The file therefore stays contiguous with no padding.
+ *
+ * On close the file is truncated to the bytes actually written. A crash leaves
+ * zero bytes after the last complete line, up to the end of the live segment.
+ *
+ * @author Meysam Zare
+ * @date October 18, 2026
+ */
+
+#ifdef _MSC_VER
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#include <io.h>
+#include <fcntl.h>
+#include <share.h>
+#include <sys/stat.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+namespace mz {
+    namespace io {
+
+        /**
+         * @class MappedLogFile
+         * @brief Lock-free multi-producer appender over a memory-mapped file
+         */
+        class MappedLogFile {
+        public:
+            /// Default size of each mapped segment (16 MiB)
+            static constexpr size_t DefaultSegmentSize{ size_t(16) << 20 };
+
+            /**
+             * @brief Constructor
+             * @param segmentSize Bytes mapped at a time; rounded up to the mapping granularity
+             */
+            explicit MappedLogFile(size_t segmentSize = DefaultSegmentSize) noexcept
+                : m_segmentSize{ roundUp(segmentSize ? segmentSize : DefaultSegmentSize) } {}
+
+            MappedLogFile(MappedLogFile const&) = delete;
+            MappedLogFile& operator=(MappedLogFile const&) = delete;
+
+            /**
+             * @brief Destructor - unmaps and trims the file
+             */
+            ~MappedLogFile() noexcept {
+                close();
+                m_segments.clear();
+            }
+
+            /**
+             * @brief Open or create the file and map the first segment
+             *
+             * @param Path Path to the file
+             * @param append Keep existing content and append after it; otherwise truncate
+             * @return true if successful, false if an error occurred
+             */
+            bool open(std::filesystem::path const& Path, bool append = true) noexcept {
+                std::lock_guard<std::mutex> lock(m_rollMutex);
+                if (m_fd != -1) {
+                    return false;
+                }
+                if (os_open(Path, append)) {
+                    return false;
+                }
+
+                int64_t length = append ? os_length() : 0;
+                if (length < 0) {
+                    os_close();
+                    return false;
+                }
+
+                // Mapping offsets must be aligned, so the first segment may start before the end
+                uint64_t offset = uint64_t(length) / Granularity() * Granularity();
+                auto first = mapSegment(offset, m_segmentSize);
+                if (!first) {
+                    os_close();
+                    return false;
+                }
+                first->cursor.store(uint64_t(length) - offset, std::memory_order_relaxed);
+                m_current.store(first.get(), std::memory_order_release);
+                m_segments.push_back(std::move(first));
+                return true;
+            }
+
+            /**
+             * @brief Checks if the file is open
+             * @return true if a segment is mapped
+             */
+            bool is_open() const noexcept { return m_current.load(std::memory_order_acquire) != nullptr; }
+
+            /**
+             * @brief Append bytes to the file
+             *
+             * Safe to call from any number of threads concurrently. Each call's
+             * bytes are contiguous in the file.
+             *
+             * @param text Bytes to append
+             * @return true if an error occurred (file closed or mapping failed), false on success
+             */
+            bool write(std::string_view text) noexcept {
+                if (text.empty()) {
+                    return !is_open();
+                }
+
+                for (;;) {
+                    Segment* seg = m_current.load(std::memory_order_acquire);
+                    if (!seg) {
+                        return true;
+                    }
+
+                    // Announce ourselves before reserving so the roller waits for our copy
+                    seg->writers.fetch_add(1);
+                    if (m_current.load() != seg) {
+                        seg->writers.fetch_sub(1);
+                        continue;
+                    }
+
+                    uint64_t start = seg->cursor.fetch_add(text.size());
+                    uint64_t end = start + text.size();
+                    if (end <= seg->size) {
+                        std::memcpy(seg->base + start, text.data(), text.size());
+                        seg->writers.fetch_sub(1, std::memory_order_release);
+                        return false;
+                    }
+
+                    if (start <= seg->size) {
+                        // Ours is the one reservation that crosses the end: we roll over
+                        size_t head = size_t(seg->size - start);
+                        std::memcpy(seg->base + start, text.data(), head);
+                        seg->writers.fetch_sub(1, std::memory_order_release);
+                        return roll(seg, text.substr(head));
+                    }
+
+                    // Entirely past the end: wait for the roller to publish the next segment
+                    seg->writers.fetch_sub(1, std::memory_order_release);
+                    m_current.wait(seg, std::memory_order_acquire);
+                }
+            }
+
+            /**
+             * @brief Force every byte written so far to disk
+             *
+             * Retired segments are written back when they are unmapped, so the
+             * file-level flush after the live segment also covers them.
+             * @return true if an error occurred, false on success
+             */
+            bool sync() noexcept {
+                std::lock_guard<std::mutex> lock(m_rollMutex);
+                Segment* seg = m_current.load(std::memory_order_acquire);
+                if (!seg) {
+                    return true;
+                }
+                uint64_t used = std::min<uint64_t>(seg->cursor.load(std::memory_order_acquire), seg->size);
+                return os_sync(*seg, size_t(used));
+            }
+
+            /**
+             * @brief Logical size of the file: every byte reserved so far
+             * @return Size in bytes, or 0 if closed
+             */
+            uint64_t size() const noexcept {
+                Segment* seg = m_current.load(std::memory_order_acquire);
+                if (!seg) {
+                    return 0;
+                }
+                return seg->offset + std::min<uint64_t>(seg->cursor.load(std::memory_order_relaxed), seg->size);
+            }
+
+            /**
+             * @brief Unmap everything and trim the file to the written length
+             *
+             * Concurrent writers that have not yet reserved space fail with an error.
+             */
+            void close() noexcept {
+                std::lock_guard<std::mutex> lock(m_rollMutex);
+                Segment* seg = m_current.exchange(nullptr);
+                m_current.notify_all();
+                if (seg) {
+                    waitForWriters(*seg);
+                    uint64_t end = seg->offset + std::min<uint64_t>(seg->cursor.load(), seg->size);
+                    os_unmap(*seg);
+                    os_truncate(end);
+                }
+                // Segment records stay allocated: a stale producer may still read them
+                os_close();
+            }
+
+        private:
+            /**
+             * @brief One mapped window of the file
+             *
+             * Retired segments stay allocated until destruction so a producer that
+             * loaded a stale pointer can still read the cursor safely.
+             */
+            struct Segment {
+                char* base{ nullptr };               ///< Start of the mapping
+                uint64_t offset{ 0 };                ///< File offset of base
+                uint64_t size{ 0 };                  ///< Mapped bytes
+                std::atomic<uint64_t> cursor{ 0 };   ///< Bytes reserved in this segment
+                std::atomic<uint32_t> writers{ 0 };  ///< Producers that may still touch base
+#ifdef _MSC_VER
+                HANDLE mapping{ nullptr };
+#endif
+            };
+
+            size_t m_segmentSize;                           ///< Bytes per segment
+            int m_fd{ -1 };                                 ///< Native file descriptor
+            std::atomic<Segment*> m_current{ nullptr };     ///< Segment producers append into
+            std::vector<std::unique_ptr<Segment>> m_segments; ///< Live and retired segments, freed on destruction, guarded by m_rollMutex
+            std::mutex m_rollMutex;                         ///< Serializes rollover, sync and close (cold paths)
+
+            /**
+             * @brief Map the next segment, finish the crossing write, publish and retire
+             * @param old The full segment
+             * @param rest Bytes of the crossing write that did not fit
+             * @return true if an error occurred, false on success
+             */
+            bool roll(Segment* old, std::string_view rest) noexcept {
+                std::lock_guard<std::mutex> lock(m_rollMutex);
+                if (m_current.load() != old) {
+                    return true; // closed underneath us
+                }
+
+                auto next = mapSegment(old->offset + old->size, std::max<uint64_t>(m_segmentSize, roundUp(rest.size())));
+                if (!next) {
+                    // Fail the rollover for everyone rather than leave waiters hanging
+                    m_current.store(nullptr);
+                    m_current.notify_all();
+                    waitForWriters(*old);
+                    os_unmap(*old);
+                    os_truncate(old->offset + old->size);
+                    return true;
+                }
+
+                std::memcpy(next->base, rest.data(), rest.size());
+                next->cursor.store(rest.size(), std::memory_order_relaxed);
+                m_current.store(next.get(), std::memory_order_release);
+                m_current.notify_all();
+                m_segments.push_back(std::move(next));
+
+                waitForWriters(*old);
+                os_unmap(*old);
+                return false;
+            }
+
+            /**
+             * @brief Spin until no producer can still copy into a segment
+             */
+            static void waitForWriters(Segment& seg) noexcept {
+                while (seg.writers.load() != 0) {
+                    std::this_thread::yield();
+                }
+            }
+
+            /**
+             * @brief Grow the file and map a new window
+             * @return The new segment, or null on failure
+             */
+            std::unique_ptr<Segment> mapSegment(uint64_t offset, uint64_t size) noexcept {
+                std::unique_ptr<Segment> seg{ new (std::nothrow) Segment{} };
+                if (!seg) {
+                    return nullptr;
+                }
+                seg->offset = offset;
+                seg->size = size;
+                if (os_map(*seg)) {
+                    return nullptr;
+                }
+                return seg;
+            }
+
+            static size_t roundUp(size_t size) noexcept {
+                size_t g = Granularity();
+                return (size + g - 1) / g * g;
+            }
+
+            //
+            // PLATFORM-SPECIFIC IMPLEMENTATIONS
+            //
+
+#ifdef _MSC_VER
+            static size_t Granularity() noexcept {
+                static const size_t g = []() { SYSTEM_INFO info; GetSystemInfo(&info); return size_t(info.dwAllocationGranularity); }();
+                return g;
+            }
+
+            int os_open(std::filesystem::path const& Path, bool append) noexcept {
+                int flags = _O_RDWR | _O_CREAT | _O_BINARY | (append ? 0 : _O_TRUNC);
+                return _sopen_s(&m_fd, Path.string().c_str(), flags, _SH_DENYNO, _S_IREAD | _S_IWRITE);
+            }
+            void os_close() noexcept { if (m_fd != -1) { _close(m_fd); m_fd = -1; } }
+            int64_t os_length() const noexcept { return _filelengthi64(m_fd); }
+            void os_truncate(uint64_t size) noexcept { _chsize_s(m_fd, int64_t(size)); }
+
+            int os_map(Segment& seg) noexcept {
+                HANDLE file = reinterpret_cast<HANDLE>(_get_osfhandle(m_fd));
+                uint64_t end = seg.offset + seg.size;
+                // A mapping larger than the file extends it
+                seg.mapping = CreateFileMappingW(file, nullptr, PAGE_READWRITE, DWORD(end >> 32), DWORD(end), nullptr);
+                if (!seg.mapping) {
+                    return -1;
+                }
+                seg.base = static_cast<char*>(MapViewOfFile(seg.mapping, FILE_MAP_WRITE, DWORD(seg.offset >> 32), DWORD(seg.offset), SIZE_T(seg.size)));
+                if (!seg.base) {
+                    CloseHandle(seg.mapping);
+                    seg.mapping = nullptr;
+                    return -1;
+                }
+                return 0;
+            }
+            void os_unmap(Segment& seg) noexcept {
+                // Start write-back so the next FlushFileBuffers finds these pages
+                if (seg.base) { FlushViewOfFile(seg.base, 0); UnmapViewOfFile(seg.base); seg.base = nullptr; }
+                if (seg.mapping) { CloseHandle(seg.mapping); seg.mapping = nullptr; }
+            }
+            bool os_sync(Segment& seg, size_t used) noexcept {
+                if (!FlushViewOfFile(seg.base, used)) return true;
+                return !FlushFileBuffers(reinterpret_cast<HANDLE>(_get_osfhandle(m_fd)));
+            }
+#else
+            static size_t Granularity() noexcept {
+                static const size_t g = size_t(::sysconf(_SC_PAGESIZE));
+                return g;
+            }
+
+            int os_open(std::filesystem::path const& Path, bool append) noexcept {
+                m_fd = ::open(Path.string().c_str(), O_RDWR | O_CREAT | (append ? 0 : O_TRUNC), 0666);
+                return m_fd == -1 ? errno : 0;
+            }
+            void os_close() noexcept { if (m_fd != -1) { ::close(m_fd); m_fd = -1; } }
+            int64_t os_length() const noexcept {
+                struct stat buf;
+                if (::fstat(m_fd, &buf)) return -1;
+                return buf.st_size;
+            }
+            void os_truncate(uint64_t size) noexcept { (void)::ftruncate(m_fd, off_t(size)); }
+
+            int os_map(Segment& seg) noexcept {
+                if (::ftruncate(m_fd, off_t(seg.offset + seg.size))) {
+                    return -1;
+                }
+                void* p = ::mmap(nullptr, size_t(seg.size), PROT_READ | PROT_WRITE, MAP_SHARED, m_fd, off_t(seg.offset));
+                if (p == MAP_FAILED) {
+                    return -1;
+                }
+                seg.base = static_cast<char*>(p);
+                return 0;
+            }
+            void os_unmap(Segment& seg) noexcept {
+                // Schedule write-back so the dirty pages reach the file before the mapping goes away
+                if (seg.base) { (void)::msync(seg.base, size_t(seg.size), MS_ASYNC); ::munmap(seg.base, size_t(seg.size)); seg.base = nullptr; }
+            }
+            bool os_sync(Segment& seg, size_t used) noexcept {
+                // msync needs a page-aligned length only on some systems; whole pages are covered anyway
+                if (used && ::msync(seg.base, used, MS_SYNC) != 0) {
+                    return true;
+                }
+                // Pages of retired segments are only reachable through the descriptor now
+#if defined(__linux__)
+                return ::fdatasync(m_fd) != 0;
+#else
+                return ::fsync(m_fd) != 0;
+#endif
+            }
+#endif
+        };
+
+    } // namespace io
+} // namespace mz
+
+#endif // IO_MAPPED_LOG_FILE_HEADER_FILE
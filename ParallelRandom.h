@@ -0,0 +1,389 @@
+/*
+MIT License
+
+Copyright (c) 2021-2024 Meysam Zare
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef MZ_PARALLEL_RANDOM_HEADER_FILE
+#define MZ_PARALLEL_RANDOM_HEADER_FILE
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+#include <algorithm>
+#include <bit>
+#include <concepts>
+#include <memory>
+#include <span>
+#include <thread>
+#include <vector>
+
+#include "Randomizer.h"
+#include "RandomBulk.h"
+
+/**
+ * @file ParallelRandom.h
+ * @brief Reproducible multi-threaded random generation
+ *
+ * The output is cut into fixed-size blocks, and block b is always generated
+ * by the seeded engine after b long jumps. Which thread runs a block only
+ * affects speed, so the result is bit-identical for any thread count.
+ *
+ * Xoshiro256ss blocks are written by the eight-lane bulk generator, whose lanes
+ * are short jumps inside the block's first jump() segment.
+ *
+ * parallelShuffle uses the same idea for a uniform permutation: a parallel
+ * scatter of every element into a random cache-sized bucket, then an
+ * independent Fisher-Yates shuffle of each bucket.
+ *
+ * @author Meysam Zare
+ * @date 2026-10-18
+ */
+
+namespace mz {
+
+    /**
+     * @brief Default block size for parallel generation
+     *
+     * Part of the output definition: changing it changes the bytes produced
+     * for a seed. Engines with a short period limit the number of blocks (see
+     * detail::longJumpLimit): Wyrand allows 2^16 blocks, 64 GiB at this size.
+     */
+    inline constexpr size_t ParallelBlockBytes{ size_t{ 1 } << 20 };
+
+    namespace detail {
+
+        /**
+         * @brief Number of distinct long-jump starting points of an engine
+         *
+         * Engines whose long jumps wrap around their period declare
+         * MaxLongJumps; block b = MaxLongJumps would repeat block 0.
+         */
+        template <typename Engine>
+        constexpr uint64_t longJumpLimit() noexcept {
+            if constexpr (requires { { Engine::MaxLongJumps } -> std::convertible_to<uint64_t>; }) {
+                return Engine::MaxLongJumps;
+            }
+            else {
+                return UINT64_MAX;
+            }
+        }
+
+        /**
+         * @brief Fill bytes from one engine, in the engine's native word order
+         */
+        template <JumpableEngine Engine>
+        void fillBytes(Engine& engine, std::byte* dst, size_t bytes) noexcept {
+            if constexpr (std::is_same_v<Engine, Xoshiro256ss>) {
+                Xoshiro256ssBulk bulk{ engine };
+                bulk.fill(std::span<std::byte>(dst, bytes));
+            }
+            else {
+                using word_type = std::conditional_t<(Engine::max() == UINT64_MAX), uint64_t, uint32_t>;
+                while (bytes >= sizeof(word_type)) {
+                    word_type w = static_cast<word_type>(engine());
+                    std::memcpy(dst, &w, sizeof(w));
+                    dst += sizeof(w);
+                    bytes -= sizeof(w);
+                }
+                if (bytes) {
+                    word_type w = static_cast<word_type>(engine());
+                    std::memcpy(dst, &w, bytes);
+                }
+            }
+        }
+
+        /**
+         * @brief Run work(worker) for workers 1..count-1 on new threads and worker 0 inline
+         *
+         * A worker whose thread cannot be created runs inline instead, so the
+         * work is always completed.
+         */
+        template <typename Work>
+        void runWorkers(unsigned count, Work&& work) noexcept {
+            std::vector<std::jthread> threads;
+            try {
+                threads.reserve(count);
+            }
+            catch (...) {
+            }
+            for (unsigned w = 1; w < count; ++w) {
+                try {
+                    threads.emplace_back(work, w);
+                }
+                catch (...) {
+                    work(w);
+                }
+            }
+            work(0u);
+        }
+
+        /**
+         * @brief Unbiased value in [0,bound) straight from a 64-bit engine (Lemire)
+         */
+        template <typename Engine>
+        uint64_t boundedFrom(Engine& engine, uint64_t bound) noexcept {
+            uint64_t high = 0;
+            uint64_t low = mul128(engine(), bound, high);
+            if (low < bound) {
+                const uint64_t threshold = (0 - bound) % bound;
+                while (low < threshold) {
+                    low = mul128(engine(), bound, high);
+                }
+            }
+            return high;
+        }
+
+        /**
+         * @brief Fisher-Yates shuffle driven directly by an engine
+         */
+        template <typename Engine, typename T>
+        void shuffleWith(Engine& engine, T* data, size_t n) noexcept {
+            for (size_t i = n; i > 1; --i) {
+                const size_t j = static_cast<size_t>(boundedFrom(engine, i));
+                std::swap(data[i - 1], data[j]);
+            }
+        }
+
+        /**
+         * @brief Number of workers for a job of `units` independent pieces
+         */
+        inline unsigned workerCount(unsigned threads, size_t units) noexcept {
+            if (threads == 0) {
+                threads = std::max(1u, std::thread::hardware_concurrency());
+            }
+            return static_cast<unsigned>(std::max<size_t>(1, std::min<size_t>(threads, units)));
+        }
+
+    } // namespace detail
+
+    /**
+     * @brief Fill a byte range from a seed using several threads
+     *
+     * @tparam Engine Jumpable engine type
+     * @param out Destination
+     * @param seed Seed; the same seed and block size always give the same bytes
+     * @param threads Number of threads, 0 for hardware concurrency
+     * @param blockBytes Block size (see ParallelBlockBytes)
+     * @return true on success; false if the range needs more blocks than the
+     *         engine has distinct long jumps, in which case out is unchanged
+     */
+    template <JumpableEngine Engine = Xoshiro256ss>
+    bool parallelFill(std::span<std::byte> out, uint64_t seed, unsigned threads = 0,
+        size_t blockBytes = ParallelBlockBytes) noexcept {
+        if (out.empty()) return true;
+        blockBytes = std::max<size_t>(blockBytes, 1);
+
+        const size_t blocks = (out.size() + blockBytes - 1) / blockBytes;
+        if (blocks > detail::longJumpLimit<Engine>()) {
+            return false;
+        }
+        const unsigned workers = detail::workerCount(threads, blocks);
+
+        detail::runWorkers(workers, [&](unsigned w) noexcept {
+            const size_t first = blocks * w / workers;
+            const size_t last = blocks * (w + 1) / workers;
+
+            Engine engine{ seed };
+            for (size_t b = 0; b < first; ++b) engine.longJump();
+
+            for (size_t b = first; b < last; ++b) {
+                Engine block = engine;
+                const size_t offset = b * blockBytes;
+                detail::fillBytes(block, out.data() + offset, std::min(blockBytes, out.size() - offset));
+                engine.longJump();
+            }
+            });
+        return true;
+    }
+
+    /**
+     * @brief Fill a span of integers from a seed using several threads
+     *
+     * Equivalent to filling the span's bytes, so the values depend only on the
+     * seed and block size.
+     *
+     * @tparam Engine Jumpable engine type
+     * @tparam T Element type
+     * @tparam N Size of the span (deduced)
+     * @param out Destination
+     * @param seed Seed
+     * @param threads Number of threads, 0 for hardware concurrency
+     * @param blockBytes Block size (see ParallelBlockBytes)
+     * @return true on success; false if the span needs too many blocks (see above)
+     */
+    template <JumpableEngine Engine = Xoshiro256ss, std::integral T, size_t N>
+        requires (!std::same_as<T, bool>)
+    bool parallelFill(std::span<T, N> out, uint64_t seed, unsigned threads = 0,
+        size_t blockBytes = ParallelBlockBytes) noexcept {
+        return parallelFill<Engine>(std::as_writable_bytes(out), seed, threads, blockBytes);
+    }
+
+    /**
+     * @brief Elements per scatter block in parallelShuffle (part of the output definition)
+     */
+    inline constexpr size_t ShuffleBlockElements{ size_t{ 1 } << 22 };
+
+    /**
+     * @brief Target bucket size in bytes in parallelShuffle (part of the output definition)
+     */
+    inline constexpr size_t ShuffleBucketBytes{ size_t{ 1 } << 20 };
+
+    /**
+     * @brief Uniformly shuffle a large span using several threads
+     *
+     * 1. The span is cut into blocks of ShuffleBlockElements; each block's
+     *    elements get independent uniform bucket labels from the block's engine
+     *    (a power-of-two bucket count sized so one bucket is about
+     *    ShuffleBucketBytes).
+     * 2. Elements are moved into a scratch buffer grouped by bucket, in block
+     *    order within each bucket.
+     * 3. Each bucket is Fisher-Yates shuffled in cache and moved back.
+     *
+     * Independent uniform labels followed by a uniform shuffle of every bucket
+     * give a uniform permutation. Block b draws from the seeded engine after b
+     * long jumps and bucket b from the same point plus one jump, so the result
+     * depends only on the seed and the span length, not on the thread count.
+     *
+     * @tparam Engine Jumpable 64-bit engine type
+     * @param data Span to shuffle
+     * @param seed Seed
+     * @param threads Number of threads, 0 for hardware concurrency
+     * @return true on success; false if the scratch buffer could not be
+     *         allocated or the span needs more blocks than the engine has
+     *         distinct long jumps, in which case data is unchanged
+     */
+    template <JumpableEngine Engine = Xoshiro256ss, typename T, size_t N>
+        requires std::movable<T> && std::default_initializable<T>
+    bool parallelShuffle(std::span<T, N> data, uint64_t seed, unsigned threads = 0) noexcept {
+        static_assert(Engine::max() == UINT64_MAX, "parallelShuffle needs a 64-bit engine");
+        const size_t n = data.size();
+        if (n < 2) return true;
+
+        const size_t buckets = std::min<size_t>(std::bit_ceil(std::max<size_t>(1, n * sizeof(T) / ShuffleBucketBytes)), 1u << 16);
+        if (buckets == 1) {
+            Engine engine{ seed };
+            engine.jump();
+            detail::shuffleWith(engine, data.data(), n);
+            return true;
+        }
+        const int shift = 64 - std::countr_zero(buckets);
+        const size_t blocks = (n + ShuffleBlockElements - 1) / ShuffleBlockElements;
+        if (std::max(blocks, buckets) > detail::longJumpLimit<Engine>()) {
+            return false;
+        }
+
+        std::unique_ptr<T[]> scratch;
+        std::vector<size_t> offsets;     // offsets[block * buckets + bucket]
+        try {
+            scratch = std::make_unique_for_overwrite<T[]>(n);
+            offsets.assign(blocks * buckets, 0);
+        }
+        catch (...) {
+            return false;
+        }
+
+        auto blockEngine = [seed](size_t b) noexcept {
+            Engine engine{ seed };
+            for (size_t i = 0; i < b; ++i) engine.longJump();
+            return engine;
+        };
+
+        // Phase 1: count labels per block
+        unsigned workers = detail::workerCount(threads, blocks);
+        detail::runWorkers(workers, [&](unsigned w) noexcept {
+            const size_t first = blocks * w / workers;
+            const size_t last = blocks * (w + 1) / workers;
+            Engine engine = blockEngine(first);
+            for (size_t b = first; b < last; ++b) {
+                Engine labels = engine;
+                size_t* counts = offsets.data() + b * buckets;
+                const size_t end = std::min(n, (b + 1) * ShuffleBlockElements);
+                for (size_t i = b * ShuffleBlockElements; i < end; ++i) {
+                    ++counts[labels() >> shift];
+                }
+                engine.longJump();
+            }
+            });
+
+        // Phase 2: exclusive prefix sum in bucket-major, block-minor order
+        std::vector<size_t> bucketStart(buckets + 1, 0);
+        size_t running = 0;
+        for (size_t k = 0; k < buckets; ++k) {
+            bucketStart[k] = running;
+            for (size_t b = 0; b < blocks; ++b) {
+                size_t count = offsets[b * buckets + k];
+                offsets[b * buckets + k] = running;
+                running += count;
+            }
+        }
+        bucketStart[buckets] = running;
+
+        // Phase 3: scatter, replaying each block's labels
+        detail::runWorkers(workers, [&](unsigned w) noexcept {
+            const size_t first = blocks * w / workers;
+            const size_t last = blocks * (w + 1) / workers;
+            Engine engine = blockEngine(first);
+            for (size_t b = first; b < last; ++b) {
+                Engine labels = engine;
+                size_t* next = offsets.data() + b * buckets;
+                const size_t end = std::min(n, (b + 1) * ShuffleBlockElements);
+                for (size_t i = b * ShuffleBlockElements; i < end; ++i) {
+                    scratch[next[labels() >> shift]++] = std::move(data[i]);
+                }
+                engine.longJump();
+            }
+            });
+
+        // Phase 4: shuffle each bucket and move it back
+        workers = detail::workerCount(threads, buckets);
+        detail::runWorkers(workers, [&](unsigned w) noexcept {
+            const size_t first = buckets * w / workers;
+            const size_t last = buckets * (w + 1) / workers;
+            Engine engine = blockEngine(first);
+            for (size_t k = first; k < last; ++k) {
+                Engine local = engine;
+                local.jump();
+                const size_t begin = bucketStart[k];
+                const size_t size = bucketStart[k + 1] - begin;
+                detail::shuffleWith(local, scratch.get() + begin, size);
+                std::move(scratch.get() + begin, scratch.get() + begin + size, data.data() + begin);
+                engine.longJump();
+            }
+            });
+        return true;
+    }
+
+    /**
+     * @brief Uniformly shuffle a large vector using several threads
+     *
+     * @see parallelShuffle(std::span<T, N>, uint64_t, unsigned)
+     */
+    template <JumpableEngine Engine = Xoshiro256ss, typename T>
+        requires std::movable<T> && std::default_initializable<T>
+    bool parallelShuffle(std::vector<T>& vec, uint64_t seed, unsigned threads = 0) noexcept {
+        return parallelShuffle<Engine>(std::span(vec), seed, threads);
+    }
+
+} // namespace mz
+
+#endif // MZ_PARALLEL_RANDOM_HEADER_FILE
@@ -0,0 +1,449 @@
+/*
+MIT License
+
+Copyright (c) 2021-2024 Meysam Zare
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef MZ_QUASI_RANDOM_HEADER_FILE
+#define MZ_QUASI_RANDOM_HEADER_FILE
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <concepts>
+#include <span>
+#include <vector>
+
+#include "RandomEngines.h"
+#include "SobolDirections.h"
+
+/**
+ * @file QuasiRandom.h
+ * @brief Low-discrepancy (quasi-random) point sequences for integration
+ *
+ * Quasi-Monte Carlo points fill [0,1)^d far more evenly than independent
+ * random points: integration error typically falls like (log N)^d / N
+ * rather than 1 / sqrt(N).
+ *
+ * - SobolSequence: Sobol points with Joe-Kuo direction numbers, up to 1024
+ *   dimensions and 2^32 points, produced in Gray-code order with one XOR per
+ *   coordinate. Use power-of-two point counts for the best balance.
+ * - HaltonSequence: radical inverses in the first d prime bases, up to 1024
+ *   dimensions. Plain Halton degrades in high dimensions; scramble it there.
+ *
+ * Scrambling randomizes a sequence while keeping its low discrepancy, which
+ * removes the all-zero first point and makes error estimates possible from
+ * several independently seeded replicates.
+ *
+ * @author Meysam Zare
+ * @date 2026-10-18
+ */
+
+namespace mz {
+
+    /**
+     * @brief Randomization applied to a quasi-random sequence
+     */
+    enum class QuasiScramble : uint8_t {
+        None,       ///< The plain sequence; its first point is the origin
+        Shift,      ///< Random digital shift of every coordinate
+        Linear,     ///< Random linear digit scramble (Matousek) followed by a digital shift
+    };
+
+    namespace detail {
+
+        template <std::floating_point T>
+        constexpr T fromBits32(uint32_t x) noexcept {
+            if constexpr (std::is_same_v<T, float>) {
+                return static_cast<float>(x >> 8) * 0x1.0p-24f;
+            }
+            else {
+                return static_cast<T>(x) * static_cast<T>(0x1.0p-32);
+            }
+        }
+
+    } // namespace detail
+
+    /**
+     * @class SobolSequence
+     * @brief Sobol points in [0,1)^d with optional scrambling
+     */
+    class SobolSequence {
+    public:
+        static constexpr unsigned MaxDimensions{ detail::SobolTableDimensions };
+        static constexpr unsigned Bits{ 32 };      ///< Resolution; the sequence has 2^Bits points
+
+        SobolSequence() noexcept = default;
+
+        /**
+         * @brief Constructor; see init()
+         */
+        explicit SobolSequence(unsigned dimensions, QuasiScramble scramble = QuasiScramble::None, uint64_t seed = 0) noexcept {
+            init(dimensions, scramble, seed);
+        }
+
+        /**
+         * @brief Set up the sequence and rewind it to the first point
+         *
+         * @param dimensions Number of coordinates per point, 1 to MaxDimensions
+         * @param scramble Scrambling mode
+         * @param seed Seed of the scramble (ignored for QuasiScramble::None)
+         * @return true on success; false for an unsupported dimension count or
+         *         if allocation fails, leaving the sequence empty
+         */
+        bool init(unsigned dimensions, QuasiScramble scramble = QuasiScramble::None, uint64_t seed = 0) noexcept {
+            m_dims = 0;
+            if (dimensions == 0 || dimensions > MaxDimensions) return false;
+            try {
+                m_v.assign(size_t{ Bits } * dimensions, 0);
+                m_shift.assign(dimensions, 0);
+                m_x.assign(dimensions, 0);
+            }
+            catch (...) {
+                return false;
+            }
+
+            Xoshiro256ss rng{ seed };
+            for (unsigned d = 0; d < dimensions; ++d) {
+                uint32_t v[Bits];
+                directionNumbers(d, v);
+                if (scramble == QuasiScramble::Linear) {
+                    linearScramble(rng, v);
+                }
+                for (unsigned k = 0; k < Bits; ++k) {
+                    m_v[size_t{ k } * dimensions + d] = v[k];
+                }
+                if (scramble != QuasiScramble::None) {
+                    m_shift[d] = static_cast<uint32_t>(rng() >> 32);
+                }
+            }
+            m_dims = dimensions;
+            seek(0);
+            return true;
+        }
+
+        [[nodiscard]] unsigned dimensions() const noexcept { return m_dims; }
+
+        /**
+         * @brief Index of the point the next call returns
+         */
+        [[nodiscard]] uint64_t index() const noexcept { return m_index; }
+
+        /**
+         * @brief Move to point `index` (of the Gray-code order) in O(d log index)
+         * @param index Point index; taken modulo 2^32
+         */
+        void seek(uint64_t index) noexcept {
+            m_index = index & 0xFFFFFFFFu;
+            const uint64_t gray = m_index ^ (m_index >> 1);
+            std::fill(m_x.begin(), m_x.end(), 0u);
+            for (unsigned k = 0; k < Bits; ++k) {
+                if ((gray >> k) & 1u) {
+                    uint32_t const* v = m_v.data() + size_t{ k } * m_dims;
+                    for (unsigned d = 0; d < m_dims; ++d) m_x[d] ^= v[d];
+                }
+            }
+        }
+
+        /**
+         * @brief The next point as raw 32-bit fractions (coordinate = value / 2^32)
+         * @param point At least dimensions() values
+         */
+        void next(std::span<uint32_t> point) noexcept {
+            for (unsigned d = 0; d < m_dims; ++d) point[d] = m_x[d] ^ m_shift[d];
+            advance();
+        }
+
+        /**
+         * @brief The next point
+         * @param point At least dimensions() values
+         */
+        template <std::floating_point T, size_t N>
+        void next(std::span<T, N> point) noexcept {
+            for (unsigned d = 0; d < m_dims; ++d) point[d] = detail::fromBits32<T>(m_x[d] ^ m_shift[d]);
+            advance();
+        }
+
+        /**
+         * @brief Fill consecutive points, row-major (out.size() / dimensions() of them)
+         * @param out Destination
+         */
+        template <std::floating_point T, size_t N>
+        void fill(std::span<T, N> out) noexcept {
+            if (m_dims == 0) return;
+            const size_t points = out.size() / m_dims;
+            for (size_t p = 0; p < points; ++p) {
+                next(std::span<T>(out.data() + p * m_dims, m_dims));
+            }
+        }
+
+        template <std::floating_point T>
+        void fill(std::vector<T>& vec) noexcept {
+            fill(std::span<T>(vec));
+        }
+
+    private:
+        unsigned m_dims{ 0 };
+        uint64_t m_index{ 0 };
+        std::vector<uint32_t> m_v;          ///< Direction numbers, m_v[k * dims + d]
+        std::vector<uint32_t> m_shift;      ///< Digital shift per dimension
+        std::vector<uint32_t> m_x;          ///< Current point before the shift
+
+        void advance() noexcept {
+            // Gray code: point n + 1 differs from point n by direction number ctz(n + 1)
+            const unsigned c = static_cast<unsigned>(std::countr_zero(m_index + 1));
+            if (c >= Bits) {
+                seek(0);        // all 2^32 points produced: start over
+                return;
+            }
+            uint32_t const* v = m_v.data() + size_t{ c } * m_dims;
+            for (unsigned d = 0; d < m_dims; ++d) m_x[d] ^= v[d];
+            ++m_index;
+        }
+
+        /**
+         * @brief Direction numbers v_k = m_k / 2^k of one dimension, as 32-bit fractions
+         */
+        static void directionNumbers(unsigned dim, uint32_t (&v)[Bits]) noexcept {
+            detail::SobolDimension const& t = detail::SobolTable[dim];
+            if (dim == 0) {
+                for (unsigned k = 0; k < Bits; ++k) v[k] = uint32_t{ 1 } << (Bits - 1 - k);
+                return;
+            }
+            const unsigned s = static_cast<unsigned>(std::bit_width(t.poly)) - 1;
+            for (unsigned k = 0; k < s && k < Bits; ++k) {
+                v[k] = static_cast<uint32_t>(t.m[k]) << (Bits - 1 - k);
+            }
+            for (unsigned k = s; k < Bits; ++k) {
+                uint32_t x = v[k - s] ^ (v[k - s] >> s);
+                for (unsigned i = 1; i < s; ++i) {
+                    if ((t.poly >> (s - i)) & 1u) x ^= v[k - i];
+                }
+                v[k] = x;
+            }
+        }
+
+        /**
+         * @brief Multiply the direction numbers by a random unit lower-triangular bit matrix
+         *
+         * Digit i of a fraction is bit (31 - i); row i of the matrix mixes
+         * digits 0..i, which keeps the (t, s)-net property of the sequence.
+         */
+        static void linearScramble(Xoshiro256ss& rng, uint32_t (&v)[Bits]) noexcept {
+            uint32_t rows[Bits];
+            for (unsigned i = 0; i < Bits; ++i) {
+                const uint32_t diagonal = uint32_t{ 1 } << (Bits - 1 - i);
+                const uint32_t lower = ~(diagonal - 1);     // digits 0..i
+                rows[i] = (static_cast<uint32_t>(rng() >> 32) & lower) | diagonal;
+            }
+            for (unsigned k = 0; k < Bits; ++k) {
+                uint32_t out = 0;
+                for (unsigned i = 0; i < Bits; ++i) {
+                    out |= static_cast<uint32_t>(std::popcount(rows[i] & v[k]) & 1) << (Bits - 1 - i);
+                }
+                v[k] = out;
+            }
+        }
+    };
+
+    /**
+     * @class HaltonSequence
+     * @brief Halton points in [0,1)^d with optional digit scrambling
+     *
+     * Coordinate d of point n is the radical inverse of n in the d-th prime.
+     * Scrambling permutes every digit with (a * digit + c) mod b, drawn per
+     * dimension and digit position (a = 1 for QuasiScramble::Shift); enough
+     * digit positions are used that the omitted ones are below double precision.
+     */
+    class HaltonSequence {
+    public:
+        static constexpr unsigned MaxDimensions{ 1024 };
+
+        HaltonSequence() noexcept = default;
+
+        /**
+         * @brief Constructor; see init()
+         */
+        explicit HaltonSequence(unsigned dimensions, QuasiScramble scramble = QuasiScramble::None, uint64_t seed = 0) noexcept {
+            init(dimensions, scramble, seed);
+        }
+
+        /**
+         * @brief Set up the sequence and rewind it to the first point
+         *
+         * @param dimensions Number of coordinates per point, 1 to MaxDimensions
+         * @param scramble Scrambling mode
+         * @param seed Seed of the scramble (ignored for QuasiScramble::None)
+         * @return true on success; false for an unsupported dimension count or
+         *         if allocation fails, leaving the sequence empty
+         */
+        bool init(unsigned dimensions, QuasiScramble scramble = QuasiScramble::None, uint64_t seed = 0) noexcept {
+            m_dims = 0;
+            m_index = 0;
+            if (dimensions == 0 || dimensions > MaxDimensions) return false;
+            try {
+                m_bases.clear();
+                m_bases.reserve(dimensions);
+                for (uint32_t candidate = 2; m_bases.size() < dimensions; ++candidate) {
+                    bool prime = true;
+                    for (uint32_t p : m_bases) {
+                        if (p * p > candidate) break;
+                        if (candidate % p == 0) { prime = false; break; }
+                    }
+                    if (prime) m_bases.push_back(candidate);
+                }
+                m_digits.assign(dimensions, 0);
+                m_scrambleOffset.assign(dimensions + 1, 0);
+                m_scrambled = scramble != QuasiScramble::None;
+                if (m_scrambled) {
+                    size_t total = 0;
+                    for (unsigned d = 0; d < dimensions; ++d) {
+                        m_digits[d] = digitCount(m_bases[d]);
+                        m_scrambleOffset[d] = total;
+                        total += m_digits[d];
+                    }
+                    m_scrambleOffset[dimensions] = total;
+                    m_mul.assign(total, 1);
+                    m_add.assign(total, 0);
+                }
+            }
+            catch (...) {
+                return false;
+            }
+
+            if (m_scrambled) {
+                Xoshiro256ss rng{ seed };
+                for (unsigned d = 0; d < dimensions; ++d) {
+                    const uint64_t b = m_bases[d];
+                    for (size_t i = m_scrambleOffset[d]; i < m_scrambleOffset[d + 1]; ++i) {
+                        if (scramble == QuasiScramble::Linear) {
+                            m_mul[i] = static_cast<uint32_t>(1 + boundedFrom(rng, b - 1));
+                        }
+                        m_add[i] = static_cast<uint32_t>(boundedFrom(rng, b));
+                    }
+                }
+            }
+            m_dims = dimensions;
+            return true;
+        }
+
+        [[nodiscard]] unsigned dimensions() const noexcept { return m_dims; }
+        [[nodiscard]] uint64_t index() const noexcept { return m_index; }
+
+        /**
+         * @brief Move to point `index`
+         */
+        void seek(uint64_t index) noexcept { m_index = index; }
+
+        /**
+         * @brief The next point
+         * @param point At least dimensions() values
+         */
+        template <std::floating_point T, size_t N>
+        void next(std::span<T, N> point) noexcept {
+            for (unsigned d = 0; d < m_dims; ++d) {
+                const double x = m_scrambled ? scrambledInverse(d, m_index) : radicalInverse(m_bases[d], m_index);
+                point[d] = std::min(static_cast<T>(x), std::nextafter(T{ 1 }, T{ 0 }));
+            }
+            ++m_index;
+        }
+
+        /**
+         * @brief Fill consecutive points, row-major (out.size() / dimensions() of them)
+         * @param out Destination
+         */
+        template <std::floating_point T, size_t N>
+        void fill(std::span<T, N> out) noexcept {
+            if (m_dims == 0) return;
+            const size_t points = out.size() / m_dims;
+            for (size_t p = 0; p < points; ++p) {
+                next(std::span<T>(out.data() + p * m_dims, m_dims));
+            }
+        }
+
+        template <std::floating_point T>
+        void fill(std::vector<T>& vec) noexcept {
+            fill(std::span<T>(vec));
+        }
+
+    private:
+        unsigned m_dims{ 0 };
+        uint64_t m_index{ 0 };
+        bool m_scrambled{ false };
+        std::vector<uint32_t> m_bases;
+        std::vector<unsigned> m_digits;             ///< Digit positions per dimension (scrambled only)
+        std::vector<size_t> m_scrambleOffset;       ///< Start of each dimension in m_mul / m_add
+        std::vector<uint32_t> m_mul;                ///< Digit permutation: (mul * digit + add) mod base
+        std::vector<uint32_t> m_add;
+
+        /**
+         * @brief Digit positions whose weight b^-k is at least 2^-53
+         */
+        static unsigned digitCount(uint64_t b) noexcept {
+            unsigned k = 0;
+            for (double weight = 1.0; weight >= 0x1.0p-53; weight /= static_cast<double>(b)) ++k;
+            return k;
+        }
+
+        static uint64_t boundedFrom(Xoshiro256ss& rng, uint64_t bound) noexcept {
+            uint64_t hi = 0;
+            uint64_t lo = detail::mul128(rng(), bound, hi);
+            if (lo < bound) {
+                const uint64_t threshold = (0 - bound) % bound;
+                while (lo < threshold) lo = detail::mul128(rng(), bound, hi);
+            }
+            return hi;
+        }
+
+        static double radicalInverse(uint32_t b, uint64_t n) noexcept {
+            const double inv = 1.0 / b;
+            double weight = inv, x = 0.0;
+            while (n) {
+                x += static_cast<double>(n % b) * weight;
+                n /= b;
+                weight *= inv;
+            }
+            return x;
+        }
+
+        double scrambledInverse(unsigned d, uint64_t n) const noexcept {
+            const uint32_t b = m_bases[d];
+            const double inv = 1.0 / b;
+            uint32_t const* mul = m_mul.data() + m_scrambleOffset[d];
+            uint32_t const* add = m_add.data() + m_scrambleOffset[d];
+            double weight = inv, x = 0.0;
+            // Zero digits are permuted too, so every digit position contributes
+            for (unsigned k = 0; k < m_digits[d]; ++k) {
+                const uint64_t digit = n % b;
+                n /= b;
+                x += static_cast<double>((mul[k] * digit + add[k]) % b) * weight;
+                weight *= inv;
+            }
+            return x;
+        }
+    };
+
+} // namespace mz
+
+#endif // MZ_QUASI_RANDOM_HEADER_FILE
@@ -0,0 +1,298 @@
+/*
+MIT License
+
+Copyright (c) 2021-2024 Meysam Zare
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef MZ_RANDOM_BULK_HEADER_FILE
+#define MZ_RANDOM_BULK_HEADER_FILE
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+#include <span>
+#include <concepts>
+#include <bit>
+
+#include "RandomEngines.h"
+
+#if defined(__AVX512F__) || defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#endif
+
+/**
+ * @file RandomBulk.h
+ * @brief Multi-lane xoshiro256** for filling large buffers
+ *
+ * Xoshiro256ssBulk runs eight independent xoshiro256** lanes in lockstep and
+ * writes one 64-byte block (one word per lane) per step straight into the
+ * destination. The lanes are 2^64 apart (Xoshiro256ss::shortJump), inside the
+ * engine's own jump() segment, so they never overlap each other, the engine
+ * they were taken from, or any stream/split sibling of that engine.
+ *
+ * The instruction set is chosen at compile time: AVX-512F (one register for
+ * all lanes), AVX2 (two registers), or a plain lane loop that compilers
+ * auto-vectorize. All three produce the same bytes.
+ *
+ * unitDoubles/unitFloats turn raw random bits into uniform [0,1) values with
+ * the exponent-bit trick: the top mantissa bits are placed under the exponent
+ * of 1.0, giving a value in [1,2), and 1.0 is subtracted.
+ *
+ * @author Meysam Zare
+ * @date 2026-10-18
+ */
+
+namespace mz {
+
+    /**
+     * @brief Convert 64-bit random words to doubles uniform in [0,1) (52 bits of precision)
+     * @param bits Random words
+     * @param out Destination, same length as bits
+     * @param n Number of values
+     */
+    inline void unitDoubles(uint64_t const* bits, double* out, size_t n) noexcept {
+        constexpr uint64_t One{ 0x3FF0000000000000ull };
+        size_t i = 0;
+#if defined(__AVX2__)
+        const __m256i one = _mm256_set1_epi64x(static_cast<long long>(One));
+        const __m256d oned = _mm256_set1_pd(1.0);
+        for (; i + 4 <= n; i += 4) {
+            __m256i v = _mm256_loadu_si256(reinterpret_cast<__m256i const*>(bits + i));
+            v = _mm256_or_si256(_mm256_srli_epi64(v, 12), one);
+            _mm256_storeu_pd(out + i, _mm256_sub_pd(_mm256_castsi256_pd(v), oned));
+        }
+#elif defined(__SSE2__) || defined(_M_X64)
+        const __m128i one = _mm_set1_epi64x(static_cast<long long>(One));
+        const __m128d oned = _mm_set1_pd(1.0);
+        for (; i + 2 <= n; i += 2) {
+            __m128i v = _mm_loadu_si128(reinterpret_cast<__m128i const*>(bits + i));
+            v = _mm_or_si128(_mm_srli_epi64(v, 12), one);
+            _mm_storeu_pd(out + i, _mm_sub_pd(_mm_castsi128_pd(v), oned));
+        }
+#endif
+        for (; i < n; ++i) {
+            out[i] = std::bit_cast<double>((bits[i] >> 12) | One) - 1.0;
+        }
+    }
+
+    /**
+     * @brief Convert 32-bit random words to floats uniform in [0,1) (23 bits of precision)
+     * @param bits Random words
+     * @param out Destination, same length as bits
+     * @param n Number of values
+     */
+    inline void unitFloats(uint32_t const* bits, float* out, size_t n) noexcept {
+        constexpr uint32_t One{ 0x3F800000u };
+        size_t i = 0;
+#if defined(__AVX2__)
+        const __m256i one = _mm256_set1_epi32(static_cast<int>(One));
+        const __m256 onef = _mm256_set1_ps(1.0f);
+        for (; i + 8 <= n; i += 8) {
+            __m256i v = _mm256_loadu_si256(reinterpret_cast<__m256i const*>(bits + i));
+            v = _mm256_or_si256(_mm256_srli_epi32(v, 9), one);
+            _mm256_storeu_ps(out + i, _mm256_sub_ps(_mm256_castsi256_ps(v), onef));
+        }
+#elif defined(__SSE2__) || defined(_M_X64)
+        const __m128i one = _mm_set1_epi32(static_cast<int>(One));
+        const __m128 onef = _mm_set1_ps(1.0f);
+        for (; i + 4 <= n; i += 4) {
+            __m128i v = _mm_loadu_si128(reinterpret_cast<__m128i const*>(bits + i));
+            v = _mm_or_si128(_mm_srli_epi32(v, 9), one);
+            _mm_storeu_ps(out + i, _mm_sub_ps(_mm_castsi128_ps(v), onef));
+        }
+#endif
+        for (; i < n; ++i) {
+            out[i] = std::bit_cast<float>((bits[i] >> 9) | One) - 1.0f;
+        }
+    }
+
+    /**
+     * @class Xoshiro256ssBulk
+     * @brief Eight interleaved xoshiro256** lanes with a bulk fill
+     */
+    class Xoshiro256ssBulk {
+    public:
+        static constexpr size_t Lanes{ 8 };
+        static constexpr size_t BlockBytes{ Lanes * sizeof(uint64_t) };
+
+        /**
+         * @brief Take the lanes from an engine
+         *
+         * Lane k starts at the engine's state after k short jumps (2^64 calls
+         * each), and the engine is left Lanes short jumps ahead, so its own
+         * later output does not overlap any lane. Everything stays inside the
+         * engine's current jump() segment: the engine can take 2^61 bulk
+         * generators before it reaches the next stream.
+         *
+         * @param engine Engine to take the lanes from (advanced by Lanes short jumps)
+         */
+        explicit Xoshiro256ssBulk(Xoshiro256ss& engine) noexcept {
+            for (size_t k = 0; k < Lanes; ++k) {
+                auto const& s = engine.state();
+                for (size_t i = 0; i < 4; ++i) m_s[i][k] = s[i];
+                engine.shortJump();
+            }
+        }
+
+        /**
+         * @brief Seed the lanes from a single value
+         * @param seed Seed value
+         */
+        explicit Xoshiro256ssBulk(uint64_t seed = Xoshiro256ss::DefaultSeed) noexcept {
+            Xoshiro256ss engine{ seed };
+            *this = Xoshiro256ssBulk{ engine };
+        }
+
+        /**
+         * @brief Fill a byte range with random data
+         *
+         * Whole blocks are written in place; a partial tail block is generated
+         * into a scratch block and copied, and its unused bytes are discarded.
+         *
+         * @param out Destination
+         */
+        void fill(std::span<std::byte> out) noexcept {
+            std::byte* dst = out.data();
+            size_t blocks = out.size() / BlockBytes;
+            fillBlocks(dst, blocks);
+
+            size_t tail = out.size() % BlockBytes;
+            if (tail) {
+                std::byte scratch[BlockBytes];
+                fillBlocks(scratch, 1);
+                std::memcpy(dst + blocks * BlockBytes, scratch, tail);
+            }
+        }
+
+        /**
+         * @brief Fill a span of integers of any width with random values
+         *
+         * @tparam T Element type
+         * @tparam N Size of the span (deduced)
+         * @param out Destination
+         */
+        template <std::integral T, size_t N>
+            requires (!std::same_as<T, bool>)
+        void fill(std::span<T, N> out) noexcept {
+            fill(std::as_writable_bytes(out));
+        }
+
+    private:
+        alignas(64) uint64_t m_s[4][Lanes];    ///< Lane-major state: m_s[word][lane]
+
+#if defined(__AVX512F__)
+        void fillBlocks(std::byte* dst, size_t blocks) noexcept {
+            __m512i s0 = _mm512_load_si512(m_s[0]);
+            __m512i s1 = _mm512_load_si512(m_s[1]);
+            __m512i s2 = _mm512_load_si512(m_s[2]);
+            __m512i s3 = _mm512_load_si512(m_s[3]);
+            for (size_t b = 0; b < blocks; ++b) {
+                __m512i x = _mm512_add_epi64(_mm512_slli_epi64(s1, 2), s1);         // s1 * 5
+                x = _mm512_rol_epi64(x, 7);
+                x = _mm512_add_epi64(_mm512_slli_epi64(x, 3), x);                    // * 9
+                _mm512_storeu_si512(dst + b * BlockBytes, x);
+
+                __m512i t = _mm512_slli_epi64(s1, 17);
+                s2 = _mm512_xor_si512(s2, s0);
+                s3 = _mm512_xor_si512(s3, s1);
+                s1 = _mm512_xor_si512(s1, s2);
+                s0 = _mm512_xor_si512(s0, s3);
+                s2 = _mm512_xor_si512(s2, t);
+                s3 = _mm512_rol_epi64(s3, 45);
+            }
+            _mm512_store_si512(m_s[0], s0);
+            _mm512_store_si512(m_s[1], s1);
+            _mm512_store_si512(m_s[2], s2);
+            _mm512_store_si512(m_s[3], s3);
+        }
+#elif defined(__AVX2__)
+        static __m256i rotl(__m256i x, int k) noexcept {
+            return _mm256_or_si256(_mm256_slli_epi64(x, k), _mm256_srli_epi64(x, 64 - k));
+        }
+
+        struct Half {
+            __m256i s0, s1, s2, s3;
+
+            explicit Half(uint64_t (&s)[4][Lanes], size_t lane) noexcept
+                : s0{ _mm256_load_si256(reinterpret_cast<__m256i const*>(s[0] + lane)) }
+                , s1{ _mm256_load_si256(reinterpret_cast<__m256i const*>(s[1] + lane)) }
+                , s2{ _mm256_load_si256(reinterpret_cast<__m256i const*>(s[2] + lane)) }
+                , s3{ _mm256_load_si256(reinterpret_cast<__m256i const*>(s[3] + lane)) } {}
+
+            void store(uint64_t (&s)[4][Lanes], size_t lane) const noexcept {
+                _mm256_store_si256(reinterpret_cast<__m256i*>(s[0] + lane), s0);
+                _mm256_store_si256(reinterpret_cast<__m256i*>(s[1] + lane), s1);
+                _mm256_store_si256(reinterpret_cast<__m256i*>(s[2] + lane), s2);
+                _mm256_store_si256(reinterpret_cast<__m256i*>(s[3] + lane), s3);
+            }
+
+            __m256i next() noexcept {
+                __m256i x = _mm256_add_epi64(_mm256_slli_epi64(s1, 2), s1);          // s1 * 5
+                x = rotl(x, 7);
+                x = _mm256_add_epi64(_mm256_slli_epi64(x, 3), x);                     // * 9
+
+                __m256i t = _mm256_slli_epi64(s1, 17);
+                s2 = _mm256_xor_si256(s2, s0);
+                s3 = _mm256_xor_si256(s3, s1);
+                s1 = _mm256_xor_si256(s1, s2);
+                s0 = _mm256_xor_si256(s0, s3);
+                s2 = _mm256_xor_si256(s2, t);
+                s3 = rotl(s3, 45);
+                return x;
+            }
+        };
+
+        void fillBlocks(std::byte* dst, size_t blocks) noexcept {
+            Half lo{ m_s, 0 }, hi{ m_s, 4 };
+            for (size_t b = 0; b < blocks; ++b) {
+                auto* out = reinterpret_cast<__m256i*>(dst + b * BlockBytes);
+                _mm256_storeu_si256(out, lo.next());
+                _mm256_storeu_si256(out + 1, hi.next());
+            }
+            lo.store(m_s, 0);
+            hi.store(m_s, 4);
+        }
+#else
+        void fillBlocks(std::byte* dst, size_t blocks) noexcept {
+            for (size_t b = 0; b < blocks; ++b) {
+                uint64_t out[Lanes];
+                for (size_t k = 0; k < Lanes; ++k) {
+                    out[k] = detail::rotl64(m_s[1][k] * 5, 7) * 9;
+                    const uint64_t t = m_s[1][k] << 17;
+                    m_s[2][k] ^= m_s[0][k];
+                    m_s[3][k] ^= m_s[1][k];
+                    m_s[1][k] ^= m_s[2][k];
+                    m_s[0][k] ^= m_s[3][k];
+                    m_s[2][k] ^= t;
+                    m_s[3][k] = detail::rotl64(m_s[3][k], 45);
+                }
+                std::memcpy(dst + b * BlockBytes, out, BlockBytes);
+            }
+        }
+#endif
+    };
+
+} // namespace mz
+
+#endif // MZ_RANDOM_BULK_HEADER_FILE
@@ -0,0 +1,401 @@
+/*
+MIT License
+
+Copyright (c) 2021-2024 Meysam Zare
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef MZ_RANDOM_DISTRIBUTIONS_HEADER_FILE
+#define MZ_RANDOM_DISTRIBUTIONS_HEADER_FILE
+#pragma once
+
+#include <cstdint>
+#include <cmath>
+#include <array>
+#include <algorithm>
+#include <span>
+#include <concepts>
+
+#include "Randomizer.h"
+
+/**
+ * @file RandomDistributions.h
+ * @brief Fast non-uniform samplers driven by a randomizer's raw 64-bit output
+ *
+ * - NormalDistribution, ExponentialDistribution: Ziggurat (Marsaglia & Tsang,
+ *   with Doornik's double-precision layer test); one 64-bit draw and one
+ *   multiply for ~99% of samples
+ * - ZipfDistribution: rejection-inversion (Hörmann & Derflinger), constant
+ *   time for any n with no per-element tables
+ * - PoissonDistribution: inversion for small means, PTRS transformed
+ *   rejection (Hörmann) for means of 10 and above
+ *
+ * Each sampler works with any source that has rand64() (BasicRandomizer of any
+ * engine) and has a fill() for spans.
+ *
+ * @author Meysam Zare
+ * @date 2026-10-18
+ */
+
+namespace mz {
+
+    /**
+     * @brief A source of uniform 64-bit random words
+     */
+    template <typename R>
+    concept RandomSource64 = requires(R & r) { { r.rand64() } -> std::same_as<uint64_t>; };
+
+    namespace detail {
+
+        /**
+         * @brief Uniform double in [0,1) with 53 bits
+         */
+        template <RandomSource64 Rng>
+        inline double unit53(Rng& rng) noexcept {
+            return static_cast<double>(rng.rand64() >> 11) * 0x1.0p-53;
+        }
+
+        /**
+         * @brief Uniform double in (0,1], safe for log()
+         */
+        template <RandomSource64 Rng>
+        inline double unit53Open(Rng& rng) noexcept {
+            return 1.0 - unit53(rng);
+        }
+
+        /**
+         * @brief Layer boundaries and density values for a Ziggurat of Layers strips
+         *
+         * x[0] is the width of the base strip's rectangle equivalent, x[1] the
+         * tail start R, and x[Layers] = 0.
+         */
+        template <size_t Layers>
+        struct ZigguratTables {
+            std::array<double, Layers + 1> x{};
+            std::array<double, Layers + 1> f{};
+            std::array<double, Layers> ratio{};    ///< x[i+1] / x[i], the fast-accept bound
+
+            template <typename Pdf, typename InversePdf>
+            ZigguratTables(double r, double v, Pdf pdf, InversePdf inverse) noexcept {
+                x[0] = v / pdf(r);
+                x[1] = r;
+                for (size_t i = 2; i < Layers; ++i) {
+                    x[i] = inverse(v / x[i - 1] + pdf(x[i - 1]));
+                }
+                x[Layers] = 0.0;
+                for (size_t i = 0; i <= Layers; ++i) f[i] = pdf(x[i]);
+                for (size_t i = 0; i < Layers; ++i) ratio[i] = x[i + 1] / x[i];
+            }
+        };
+
+        inline ZigguratTables<128> const& normalTables() noexcept {
+            static const ZigguratTables<128> tables{ 3.442619855899, 9.91256303526217e-3,
+                [](double x) { return std::exp(-0.5 * x * x); },
+                [](double y) { return std::sqrt(-2.0 * std::log(y)); } };
+            return tables;
+        }
+
+        inline ZigguratTables<256> const& exponentialTables() noexcept {
+            static const ZigguratTables<256> tables{ 7.69711747013104972, 3.949659822581557e-3,
+                [](double x) { return std::exp(-x); },
+                [](double y) { return -std::log(y); } };
+            return tables;
+        }
+
+    } // namespace detail
+
+    /**
+     * @class NormalDistribution
+     * @brief Gaussian samples by the Ziggurat method
+     */
+    class NormalDistribution {
+    public:
+        explicit NormalDistribution(double mean = 0.0, double stddev = 1.0) noexcept
+            : m_mean{ mean }, m_stddev{ stddev } {}
+
+        [[nodiscard]] double mean() const noexcept { return m_mean; }
+        [[nodiscard]] double stddev() const noexcept { return m_stddev; }
+
+        template <RandomSource64 Rng>
+        [[nodiscard]] double operator()(Rng& rng) const noexcept {
+            return m_mean + m_stddev * standard(rng);
+        }
+
+        /**
+         * @brief Fill a span with samples
+         */
+        template <RandomSource64 Rng, std::floating_point T, size_t N>
+        void fill(Rng& rng, std::span<T, N> out) const noexcept {
+            for (auto& v : out) v = static_cast<T>((*this)(rng));
+        }
+
+        /**
+         * @brief One standard normal sample
+         *
+         * The low 7 bits of a draw pick the layer and the top 53 bits give a
+         * signed position inside it.
+         */
+        template <RandomSource64 Rng>
+        [[nodiscard]] static double standard(Rng& rng) noexcept {
+            auto const& t = detail::normalTables();
+            for (;;) {
+                const uint64_t bits = rng.rand64();
+                const size_t i = bits & 0x7F;
+                const double u = static_cast<double>(bits >> 11) * 0x1.0p-52 - 1.0;   // [-1,1)
+
+                if (std::abs(u) < t.ratio[i]) {
+                    return u * t.x[i];
+                }
+                if (i == 0) {
+                    return tail(rng, u < 0);
+                }
+                const double x = u * t.x[i];
+                const double y = t.f[i] + detail::unit53(rng) * (t.f[i + 1] - t.f[i]);
+                if (y < std::exp(-0.5 * x * x)) {
+                    return x;
+                }
+            }
+        }
+
+    private:
+        double m_mean;
+        double m_stddev;
+
+        template <RandomSource64 Rng>
+        static double tail(Rng& rng, bool negative) noexcept {
+            constexpr double R{ 3.442619855899 };
+            double x, y;
+            do {
+                x = std::log(detail::unit53Open(rng)) / R;
+                y = std::log(detail::unit53Open(rng));
+            } while (-2.0 * y < x * x);
+            return negative ? x - R : R - x;
+        }
+    };
+
+    /**
+     * @class ExponentialDistribution
+     * @brief Exponential samples by the Ziggurat method
+     */
+    class ExponentialDistribution {
+    public:
+        explicit ExponentialDistribution(double lambda = 1.0) noexcept : m_lambda{ lambda } {}
+
+        [[nodiscard]] double lambda() const noexcept { return m_lambda; }
+
+        template <RandomSource64 Rng>
+        [[nodiscard]] double operator()(Rng& rng) const noexcept {
+            return standard(rng) / m_lambda;
+        }
+
+        /**
+         * @brief Fill a span with samples
+         */
+        template <RandomSource64 Rng, std::floating_point T, size_t N>
+        void fill(Rng& rng, std::span<T, N> out) const noexcept {
+            for (auto& v : out) v = static_cast<T>((*this)(rng));
+        }
+
+        /**
+         * @brief One sample with rate 1
+         */
+        template <RandomSource64 Rng>
+        [[nodiscard]] static double standard(Rng& rng) noexcept {
+            auto const& t = detail::exponentialTables();
+            constexpr double R{ 7.69711747013104972 };
+            double offset = 0.0;
+            for (;;) {
+                const uint64_t bits = rng.rand64();
+                const size_t i = bits & 0xFF;
+                const double u = static_cast<double>(bits >> 11) * 0x1.0p-53;        // [0,1)
+
+                if (u < t.ratio[i]) {
+                    return offset + u * t.x[i];
+                }
+                if (i == 0) {
+                    // The tail is itself exponential, shifted by R
+                    offset += R;
+                    continue;
+                }
+                const double x = u * t.x[i];
+                const double y = t.f[i] + detail::unit53(rng) * (t.f[i + 1] - t.f[i]);
+                if (y < std::exp(-x)) {
+                    return offset + x;
+                }
+            }
+        }
+
+    private:
+        double m_lambda;
+    };
+
+    /**
+     * @class ZipfDistribution
+     * @brief Zipf samples over {1, ..., n} with P(k) proportional to k^-s
+     *
+     * Rejection-inversion needs no tables, so n can be in the billions. The
+     * exponent must be positive; s = 1 is the classic Zipf law.
+     */
+    class ZipfDistribution {
+    public:
+        ZipfDistribution(uint64_t n, double s) noexcept
+            : m_n{ std::max<uint64_t>(n, 1) }, m_s{ s } {
+            m_hIntegralX1 = hIntegral(1.5) - 1.0;
+            m_hIntegralN = hIntegral(static_cast<double>(m_n) + 0.5);
+            m_threshold = 2.0 - hIntegralInverse(hIntegral(2.5) - h(2.0));
+        }
+
+        [[nodiscard]] uint64_t n() const noexcept { return m_n; }
+        [[nodiscard]] double exponent() const noexcept { return m_s; }
+
+        template <RandomSource64 Rng>
+        [[nodiscard]] uint64_t operator()(Rng& rng) const noexcept {
+            for (;;) {
+                const double u = m_hIntegralN + detail::unit53(rng) * (m_hIntegralX1 - m_hIntegralN);
+                const double x = hIntegralInverse(u);
+                double kd = std::floor(x + 0.5);
+                kd = std::clamp(kd, 1.0, static_cast<double>(m_n));
+                const uint64_t k = static_cast<uint64_t>(kd);
+                if (kd - x <= m_threshold || u >= hIntegral(kd + 0.5) - h(kd)) {
+                    return k;
+                }
+            }
+        }
+
+        /**
+         * @brief Fill a span with samples
+         */
+        template <RandomSource64 Rng, std::integral T, size_t N>
+        void fill(Rng& rng, std::span<T, N> out) const noexcept {
+            for (auto& v : out) v = static_cast<T>((*this)(rng));
+        }
+
+    private:
+        uint64_t m_n;
+        double m_s;
+        double m_hIntegralX1{ 0 };
+        double m_hIntegralN{ 0 };
+        double m_threshold{ 0 };
+
+        /// log1p(x) / x, stable near 0
+        static double helper1(double x) noexcept {
+            return std::abs(x) > 1e-8 ? std::log1p(x) / x : 1.0 - x * (0.5 - x * (1.0 / 3.0 - 0.25 * x));
+        }
+
+        /// expm1(x) / x, stable near 0
+        static double helper2(double x) noexcept {
+            return std::abs(x) > 1e-8 ? std::expm1(x) / x : 1.0 + x * 0.5 * (1.0 + x / 3.0 * (1.0 + 0.25 * x));
+        }
+
+        double h(double x) const noexcept { return std::exp(-m_s * std::log(x)); }
+
+        double hIntegral(double x) const noexcept {
+            const double logX = std::log(x);
+            return helper2((1.0 - m_s) * logX) * logX;
+        }
+
+        double hIntegralInverse(double x) const noexcept {
+            double t = x * (1.0 - m_s);
+            if (t < -1.0) t = -1.0;
+            return std::exp(helper1(t) * x);
+        }
+    };
+
+    /**
+     * @class PoissonDistribution
+     * @brief Poisson samples for any mean
+     */
+    class PoissonDistribution {
+    public:
+        explicit PoissonDistribution(double mean = 1.0) noexcept : m_mean{ std::max(mean, 0.0) } {
+            if (m_mean < PtrsThreshold) {
+                m_expMean = std::exp(-m_mean);
+            }
+            else {
+                const double slam = std::sqrt(m_mean);
+                m_logMean = std::log(m_mean);
+                m_b = 0.931 + 2.53 * slam;
+                m_a = -0.059 + 0.02483 * m_b;
+                m_logInvAlpha = std::log(1.1239 + 1.1328 / (m_b - 3.4));
+                m_vr = 0.9277 - 3.6224 / (m_b - 2.0);
+            }
+        }
+
+        [[nodiscard]] double mean() const noexcept { return m_mean; }
+
+        template <RandomSource64 Rng>
+        [[nodiscard]] uint64_t operator()(Rng& rng) const noexcept {
+            return m_mean < PtrsThreshold ? inversion(rng) : ptrs(rng);
+        }
+
+        /**
+         * @brief Fill a span with samples
+         */
+        template <RandomSource64 Rng, std::integral T, size_t N>
+        void fill(Rng& rng, std::span<T, N> out) const noexcept {
+            for (auto& v : out) v = static_cast<T>((*this)(rng));
+        }
+
+    private:
+        static constexpr double PtrsThreshold{ 10.0 };
+
+        double m_mean;
+        double m_expMean{ 0 };
+        double m_logMean{ 0 };
+        double m_a{ 0 }, m_b{ 0 }, m_logInvAlpha{ 0 }, m_vr{ 0 };
+
+        template <RandomSource64 Rng>
+        uint64_t inversion(Rng& rng) const noexcept {
+            uint64_t k = 0;
+            double p = m_expMean;
+            double sum = p;
+            const double u = detail::unit53(rng);
+            while (u > sum && p > 0.0) {
+                ++k;
+                p *= m_mean / static_cast<double>(k);
+                sum += p;
+            }
+            return k;
+        }
+
+        template <RandomSource64 Rng>
+        uint64_t ptrs(Rng& rng) const noexcept {
+            for (;;) {
+                const double u = detail::unit53(rng) - 0.5;
+                const double v = detail::unit53Open(rng);
+                const double us = 0.5 - std::abs(u);
+                const double k = std::floor((2.0 * m_a / us + m_b) * u + m_mean + 0.43);
+                if (us >= 0.07 && v <= m_vr) {
+                    return static_cast<uint64_t>(k);
+                }
+                if (k < 0.0 || (us < 0.013 && v > us)) {
+                    continue;
+                }
+                if (std::log(v) + m_logInvAlpha - std::log(m_a / (us * us) + m_b)
+                    <= -m_mean + k * m_logMean - std::lgamma(k + 1.0)) {
+                    return static_cast<uint64_t>(k);
+                }
+            }
+        }
+    };
+
+} // namespace mz
+
+#endif // MZ_RANDOM_DISTRIBUTIONS_HEADER_FILE
@@ -0,0 +1,482 @@
+/*
+MIT License
+
+Copyright (c) 2021-2024 Meysam Zare
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef MZ_RANDOM_ENGINES_HEADER_FILE
+#define MZ_RANDOM_ENGINES_HEADER_FILE
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <array>
+#include <limits>
+#include <type_traits>
+#include <vector>
+
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#endif
+
+/**
+ * @file RandomEngines.h
+ * @brief Small-state 64-bit pseudo-random engines for use with BasicRandomizer
+ *
+ * All engines satisfy std::uniform_random_bit_generator with a full 64-bit
+ * output range, so they work with the standard distributions as well as with
+ * BasicRandomizer's native 64-bit paths:
+ * - Xoshiro256ss: xoshiro256** (Blackman & Vigna), 32 bytes of state, period 2^256-1
+ * - Pcg64: PCG XSL-RR 128/64 (O'Neill), 32 bytes of state, period 2^128 per stream
+ * - Wyrand: wyrand (Wang Yi), 8 bytes of state, period 2^64
+ *
+ * Every engine supports jump() and longJump() to skip ahead in its sequence
+ * and split(n) to partition it into n non-overlapping subsequences.
+ *
+ * None of these is cryptographically secure.
+ *
+ * @author Meysam Zare
+ * @date 2026-10-18
+ */
+
+namespace mz {
+    namespace detail {
+
+        /**
+         * @brief Full 64x64 -> 128-bit multiply
+         * @param a First factor
+         * @param b Second factor
+         * @param hi Receives the upper 64 bits
+         * @return The lower 64 bits
+         */
+        inline constexpr uint64_t mul128(uint64_t a, uint64_t b, uint64_t& hi) noexcept {
+#if defined(__SIZEOF_INT128__)
+            unsigned __int128 p = static_cast<unsigned __int128>(a) * b;
+            hi = static_cast<uint64_t>(p >> 64);
+            return static_cast<uint64_t>(p);
+#else
+            if (!std::is_constant_evaluated()) {
+#if defined(_MSC_VER) && defined(_M_X64)
+                return _umul128(a, b, &hi);
+#endif
+            }
+            uint64_t aLo = a & 0xFFFFFFFFu, aHi = a >> 32;
+            uint64_t bLo = b & 0xFFFFFFFFu, bHi = b >> 32;
+            uint64_t ll = aLo * bLo, lh = aLo * bHi, hl = aHi * bLo, hh = aHi * bHi;
+            uint64_t mid = (ll >> 32) + (lh & 0xFFFFFFFFu) + (hl & 0xFFFFFFFFu);
+            hi = hh + (lh >> 32) + (hl >> 32) + (mid >> 32);
+            return (mid << 32) | (ll & 0xFFFFFFFFu);
+#endif
+        }
+
+        /**
+         * @brief Minimal unsigned 128-bit integer for the PCG state
+         */
+        struct uint128 {
+            uint64_t hi{ 0 };
+            uint64_t lo{ 0 };
+
+            friend constexpr uint128 operator+(uint128 a, uint128 b) noexcept {
+                uint64_t lo = a.lo + b.lo;
+                return { a.hi + b.hi + (lo < a.lo), lo };
+            }
+            friend constexpr uint128 operator*(uint128 a, uint128 b) noexcept {
+                uint64_t hi = 0;
+                uint64_t lo = mul128(a.lo, b.lo, hi);
+                return { hi + a.lo * b.hi + a.hi * b.lo, lo };
+            }
+            friend constexpr bool operator==(uint128, uint128) noexcept = default;
+
+            constexpr bool bit(int i) const noexcept {
+                return ((i < 64 ? lo >> i : hi >> (i - 64)) & 1u) != 0;
+            }
+        };
+
+        /**
+         * @brief n non-overlapping engines: a copy of the engine, then one jump(), repeated
+         *
+         * Leaves the engine at the start of what would be the (n+1)-th part.
+         */
+        template <typename Engine>
+        [[nodiscard]] std::vector<Engine> split(Engine& engine, size_t n) {
+            std::vector<Engine> parts;
+            parts.reserve(n);
+            for (size_t i = 0; i < n; ++i) {
+                parts.push_back(engine);
+                engine.jump();
+            }
+            return parts;
+        }
+
+        constexpr uint64_t rotl64(uint64_t x, int k) noexcept { return (x << k) | (x >> ((64 - k) & 63)); }
+        constexpr uint64_t rotr64(uint64_t x, int k) noexcept { return (x >> k) | (x << ((64 - k) & 63)); }
+
+    } // namespace detail
+
+    /**
+     * @class SplitMix64
+     * @brief Tiny 64-bit generator used to expand a seed into engine state
+     */
+    class SplitMix64 {
+    public:
+        using result_type = uint64_t;
+        static constexpr result_type min() noexcept { return 0; }
+        static constexpr result_type max() noexcept { return std::numeric_limits<uint64_t>::max(); }
+
+        constexpr explicit SplitMix64(uint64_t seed = 0) noexcept : m_state{ seed } {}
+
+        constexpr result_type operator()() noexcept {
+            uint64_t z = (m_state += 0x9E3779B97F4A7C15ull);
+            z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+            z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+            return z ^ (z >> 31);
+        }
+
+        [[nodiscard]] constexpr uint64_t state() const noexcept { return m_state; }
+        constexpr void setState(uint64_t state) noexcept { m_state = state; }
+
+    private:
+        uint64_t m_state;
+    };
+
+    /**
+     * @class Xoshiro256ss
+     * @brief xoshiro256** 1.0, the general-purpose 64-bit engine
+     */
+    class Xoshiro256ss {
+    public:
+        using result_type = uint64_t;
+        static constexpr result_type min() noexcept { return 0; }
+        static constexpr result_type max() noexcept { return std::numeric_limits<uint64_t>::max(); }
+        static constexpr uint64_t DefaultSeed{ 5489u };
+
+        constexpr explicit Xoshiro256ss(uint64_t seed = DefaultSeed) noexcept { this->seed(seed); }
+
+        /**
+         * @brief Reseed by expanding the value with SplitMix64 (never yields the all-zero state)
+         * @param seed Seed value
+         */
+        constexpr void seed(uint64_t seed) noexcept {
+            SplitMix64 sm{ seed };
+            for (auto& word : m_s) word = sm();
+        }
+
+        constexpr result_type operator()() noexcept {
+            const uint64_t result = detail::rotl64(m_s[1] * 5, 7) * 9;
+            const uint64_t t = m_s[1] << 17;
+            m_s[2] ^= m_s[0];
+            m_s[3] ^= m_s[1];
+            m_s[1] ^= m_s[2];
+            m_s[0] ^= m_s[3];
+            m_s[2] ^= t;
+            m_s[3] = detail::rotl64(m_s[3], 45);
+            return result;
+        }
+
+        constexpr void discard(uint64_t n) noexcept { while (n--) (*this)(); }
+
+        /**
+         * @brief Advance by 2^64 calls; 2^64 subsequences inside one jump() segment
+         */
+        constexpr void shortJump() noexcept {
+            applyJump({ 0xB13C16E8096F0754ull, 0xB60D6C5B8C78F106ull, 0x34FAFF184785C20Aull, 0x12E4A2FBFC19BFF9ull });
+        }
+
+        /**
+         * @brief Advance by 2^128 calls; 2^128 non-overlapping subsequences for parallel use
+         */
+        constexpr void jump() noexcept {
+            applyJump({ 0x180EC6D33CFD0ABAull, 0xD5A61266F0C9392Cull, 0xA9582618E03FC9AAull, 0x39ABDC4529B1661Cull });
+        }
+
+        /**
+         * @brief Advance by 2^192 calls; 2^64 starting points, each with 2^64 jump() subsequences
+         */
+        constexpr void longJump() noexcept {
+            applyJump({ 0x76E15D3EFEFDCBBFull, 0xC5004E441C522FB3ull, 0x77710069854EE241ull, 0x39109BB02ACBE635ull });
+        }
+
+        /**
+         * @brief Partition into n subsequences of 2^128 outputs each
+         * @param n Number of parts
+         * @return Engines for the parts; this engine moves past the last one
+         */
+        [[nodiscard]] std::vector<Xoshiro256ss> split(size_t n) { return detail::split(*this, n); }
+
+        /**
+         * @brief Engine for stream `index` of a seed: the seeded engine jumped `index` times
+         * @param seed Master seed
+         * @param index Stream index
+         * @return Engine whose output does not overlap any other index of the same seed
+         */
+        [[nodiscard]] static constexpr Xoshiro256ss stream(uint64_t seed, uint64_t index) noexcept {
+            Xoshiro256ss engine{ seed };
+            while (index--) engine.jump();
+            return engine;
+        }
+
+        /**
+         * @brief Raw engine state
+         */
+        [[nodiscard]] constexpr std::array<uint64_t, 4> const& state() const noexcept { return m_s; }
+
+        /**
+         * @brief Restore a raw state taken from state()
+         * @param s State words
+         * @return true on success; false (engine unchanged) for the invalid all-zero state
+         */
+        constexpr bool setState(std::array<uint64_t, 4> const& s) noexcept {
+            if ((s[0] | s[1] | s[2] | s[3]) == 0) return false;
+            m_s = s;
+            return true;
+        }
+
+        friend constexpr bool operator==(Xoshiro256ss const&, Xoshiro256ss const&) noexcept = default;
+
+    private:
+        std::array<uint64_t, 4> m_s{};
+
+        constexpr void applyJump(std::array<uint64_t, 4> const& poly) noexcept {
+            std::array<uint64_t, 4> acc{};
+            for (uint64_t word : poly) {
+                for (int b = 0; b < 64; ++b) {
+                    if (word & (uint64_t{ 1 } << b)) {
+                        for (size_t i = 0; i < 4; ++i) acc[i] ^= m_s[i];
+                    }
+                    (*this)();
+                }
+            }
+            m_s = acc;
+        }
+    };
+
+    /**
+     * @class Pcg64
+     * @brief PCG XSL-RR 128/64 with a selectable stream
+     */
+    class Pcg64 {
+    public:
+        using result_type = uint64_t;
+        static constexpr result_type min() noexcept { return 0; }
+        static constexpr result_type max() noexcept { return std::numeric_limits<uint64_t>::max(); }
+        static constexpr uint64_t DefaultSeed{ 5489u };
+
+        static constexpr detail::uint128 Multiplier{ 0x2360ED051FC65DA4ull, 0x4385DF649FCCF645ull };
+        static constexpr detail::uint128 DefaultIncrement{ 0x5851F42D4C957F2Dull, 0x14057B7EF767814Full };
+        static constexpr uint64_t MaxLongJumps{ uint64_t{ 1 } << 32 };    ///< Distinct longJump() starts before the stream wraps
+
+        constexpr explicit Pcg64(uint64_t seed = DefaultSeed) noexcept { this->seed(seed); }
+
+        /**
+         * @brief Constructor selecting one of 2^127 independent streams
+         * @param seed Initial state
+         * @param stream Stream selector
+         */
+        constexpr Pcg64(uint64_t seed, uint64_t stream) noexcept { this->seed(seed, stream); }
+
+        /**
+         * @brief Reseed on the default stream
+         * @param seed Seed value
+         */
+        constexpr void seed(uint64_t seed) noexcept {
+            m_inc = DefaultIncrement;
+            init(seed);
+        }
+
+        /**
+         * @brief Reseed on a specific stream
+         * @param seed Seed value
+         * @param stream Stream selector
+         */
+        constexpr void seed(uint64_t seed, uint64_t stream) noexcept {
+            m_inc = { stream >> 63, (stream << 1) | 1u };
+            init(seed);
+        }
+
+        constexpr result_type operator()() noexcept {
+            step();
+            return detail::rotr64(m_state.hi ^ m_state.lo, int(m_state.hi >> 58));
+        }
+
+        constexpr void discard(uint64_t n) noexcept { advance({ 0, n }); }
+
+        /**
+         * @brief Advance by 2^64 calls on the same stream
+         */
+        constexpr void jump() noexcept { advance({ 1, 0 }); }
+
+        /**
+         * @brief Advance by 2^96 calls on the same stream
+         */
+        constexpr void longJump() noexcept { advance({ uint64_t{ 1 } << 32, 0 }); }
+
+        /**
+         * @brief Partition the current stream into n subsequences of 2^64 outputs each
+         * @param n Number of parts
+         * @return Engines for the parts; this engine moves past the last one
+         */
+        [[nodiscard]] std::vector<Pcg64> split(size_t n) { return detail::split(*this, n); }
+
+        /**
+         * @brief Advance the LCG by an arbitrary distance in O(log delta) (Brown, 1994)
+         * @param delta Number of steps
+         */
+        constexpr void advance(detail::uint128 delta) noexcept {
+            detail::uint128 accMult{ 0, 1 }, accPlus{};
+            detail::uint128 curMult = Multiplier, curPlus = m_inc;
+            for (int i = 0; i < 128; ++i) {
+                if (delta.bit(i)) {
+                    accMult = accMult * curMult;
+                    accPlus = accPlus * curMult + curPlus;
+                }
+                curPlus = (curMult + detail::uint128{ 0, 1 }) * curPlus;
+                curMult = curMult * curMult;
+            }
+            m_state = accMult * m_state + accPlus;
+        }
+
+        /**
+         * @brief Engine for stream `index` of a seed
+         *
+         * The index is the PCG stream selector, so every index has its own LCG
+         * increment. Streams that differ only in the increment and start from
+         * the same state are visibly correlated, so the index is also
+         * scrambled with SplitMix64 into the initial state.
+         *
+         * @param seed Master seed
+         * @param index Stream index
+         * @return Engine on its own LCG increment with an index-dependent start
+         */
+        [[nodiscard]] static constexpr Pcg64 stream(uint64_t seed, uint64_t index) noexcept {
+            Pcg64 engine{ seed, index };
+            SplitMix64 sm{ seed ^ SplitMix64{ index }() };
+            engine.m_state = engine.m_state + detail::uint128{ sm(), sm() };
+            return engine;
+        }
+
+        /**
+         * @brief Raw engine state: LCG state (high, low) then increment (high, low)
+         */
+        [[nodiscard]] constexpr std::array<uint64_t, 4> state() const noexcept {
+            return { m_state.hi, m_state.lo, m_inc.hi, m_inc.lo };
+        }
+
+        /**
+         * @brief Restore a raw state taken from state()
+         * @param s State words
+         * @return true on success; false (engine unchanged) if the increment is even
+         */
+        constexpr bool setState(std::array<uint64_t, 4> const& s) noexcept {
+            if ((s[3] & 1u) == 0) return false;
+            m_state = { s[0], s[1] };
+            m_inc = { s[2], s[3] };
+            return true;
+        }
+
+        friend constexpr bool operator==(Pcg64 const&, Pcg64 const&) noexcept = default;
+
+    private:
+        detail::uint128 m_state{};
+        detail::uint128 m_inc{ DefaultIncrement };
+
+        constexpr void step() noexcept { m_state = m_state * Multiplier + m_inc; }
+
+        constexpr void init(uint64_t seed) noexcept {
+            m_state = {};
+            step();
+            m_state = m_state + detail::uint128{ 0, seed };
+            step();
+        }
+    };
+
+    /**
+     * @class Wyrand
+     * @brief wyrand: one 64-bit counter and a 128-bit multiply per output
+     */
+    class Wyrand {
+    public:
+        using result_type = uint64_t;
+        static constexpr result_type min() noexcept { return 0; }
+        static constexpr result_type max() noexcept { return std::numeric_limits<uint64_t>::max(); }
+        static constexpr uint64_t DefaultSeed{ 5489u };
+        static constexpr uint64_t Increment{ 0xA0761D6478BD642Full };
+        static constexpr uint64_t StreamSpacing{ uint64_t{ 1 } << 40 };   ///< Outputs per stream and per jump()
+        static constexpr uint64_t LongJumpSpacing{ uint64_t{ 1 } << 48 }; ///< Outputs per longJump()
+        static constexpr uint64_t MaxLongJumps{ uint64_t{ 1 } << 16 };    ///< Distinct longJump() starts before the period wraps
+
+        constexpr explicit Wyrand(uint64_t seed = DefaultSeed) noexcept : m_state{ seed } {}
+
+        constexpr void seed(uint64_t seed) noexcept { m_state = seed; }
+
+        constexpr result_type operator()() noexcept {
+            m_state += Increment;
+            uint64_t hi = 0;
+            uint64_t lo = detail::mul128(m_state, m_state ^ 0xE7037ED1A0B428DBull, hi);
+            return hi ^ lo;
+        }
+
+        constexpr void discard(uint64_t n) noexcept { m_state += n * Increment; }
+
+        /**
+         * @brief Advance by 2^40 calls (the full period is only 2^64)
+         */
+        constexpr void jump() noexcept { discard(StreamSpacing); }
+
+        /**
+         * @brief Advance by 2^48 calls
+         */
+        constexpr void longJump() noexcept { discard(LongJumpSpacing); }
+
+        /**
+         * @brief Partition into n subsequences of 2^40 outputs each (at most 2^24 parts)
+         * @param n Number of parts
+         * @return Engines for the parts; this engine moves past the last one
+         */
+        [[nodiscard]] std::vector<Wyrand> split(size_t n) { return detail::split(*this, n); }
+
+        /**
+         * @brief Engine for stream `index` of a seed: the seeded counter advanced by index * StreamSpacing
+         *
+         * The state is a Weyl sequence, so streams are disjoint for the first
+         * StreamSpacing outputs of each and for indices below 2^24.
+         *
+         * @param seed Master seed
+         * @param index Stream index
+         * @return Engine positioned at the start of the stream
+         */
+        [[nodiscard]] static constexpr Wyrand stream(uint64_t seed, uint64_t index) noexcept {
+            Wyrand engine{ seed };
+            engine.discard(index * StreamSpacing);
+            return engine;
+        }
+
+        [[nodiscard]] constexpr uint64_t state() const noexcept { return m_state; }
+        constexpr void setState(uint64_t state) noexcept { m_state = state; }
+
+        friend constexpr bool operator==(Wyrand const&, Wyrand const&) noexcept = default;
+
+    private:
+        uint64_t m_state;
+    };
+
+} // namespace mz
+
+#endif // MZ_RANDOM_ENGINES_HEADER_FILE
@@ -0,0 +1,219 @@
+/*
+MIT License
+
+Copyright (c) 2021-2024 Meysam Zare
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef MZ_RANDOM_FILE_HEADER_FILE
+#define MZ_RANDOM_FILE_HEADER_FILE
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <filesystem>
+#include <memory>
+#include <new>
+#include <optional>
+#include <random>
+
+#include "FileIO.h"
+#include "ParallelRandom.h"
+
+/**
+ * @file RandomFile.h
+ * @brief Synthetic random data files written at disk speed
+ *
+ * The file is cut into chunks of RandomFileChunkBytes. Each worker thread
+ * generates whole chunks into its own buffer and writes them with a
+ * positional write, so generation and I/O overlap across threads and no
+ * thread waits on a shared file position. Chunk c comes from the seeded
+ * engine after c long jumps (as in parallelFill), so a fixed seed gives the
+ * same file for any thread count.
+ *
+ * The compressibility knob zeroes the leading fraction of every segment, the
+ * same layout fio uses for buffer_compress_percentage: a compressor removes
+ * the zero run and cannot shrink the random remainder.
+ *
+ * @author Meysam Zare
+ * @date 2026-10-18
+ */
+
+namespace mz {
+
+    /**
+     * @brief Chunk size of random file generation (part of the output definition)
+     */
+    inline constexpr size_t RandomFileChunkBytes{ size_t{ 1 } << 22 };
+
+    /**
+     * @brief Options for random file generation
+     */
+    struct RandomFileOptions {
+        std::optional<uint64_t> seed;       ///< Seed for reproducible content; drawn from std::random_device when empty
+        double compressibility{ 0.0 };      ///< Fraction of every segment that is zero, 0 to 1
+        size_t segmentBytes{ 4096 };        ///< Granularity of the zero fraction
+        unsigned threads{ 0 };              ///< Worker threads, 0 for hardware concurrency
+    };
+
+    namespace detail {
+
+        inline uint64_t randomFileSeed(RandomFileOptions const& options) noexcept {
+            if (options.seed) return *options.seed;
+            try {
+                std::random_device device;
+                return (static_cast<uint64_t>(device()) << 32) | device();
+            }
+            catch (...) {
+                return static_cast<uint64_t>(std::chrono::steady_clock::now().time_since_epoch().count());
+            }
+        }
+
+        /**
+         * @brief Zero the leading `zero` bytes of every file segment inside a chunk
+         *
+         * Segments are aligned to the start of the file, not of the chunk.
+         */
+        inline void zeroSegments(std::byte* chunk, size_t bytes, uint64_t offset, size_t segment, size_t zero) noexcept {
+            size_t phase = static_cast<size_t>(offset % segment);
+            for (size_t i = 0; i < bytes; phase = 0) {
+                if (phase < zero) {
+                    std::memset(chunk + i, 0, std::min(zero - phase, bytes - i));
+                }
+                i += std::min(segment - phase, bytes - i);
+            }
+        }
+
+    } // namespace detail
+
+    /**
+     * @brief Write `bytes` random bytes to the start of an open file
+     *
+     * The file is not truncated; bytes past the written range are left alone.
+     * Handles opened with O_APPEND are rejected, since positional writes on
+     * them would land at the end of the file.
+     *
+     * @tparam Engine Jumpable engine type
+     * @param file File opened for writing, without O_APPEND
+     * @param bytes Number of bytes to write
+     * @param options Generation options
+     * @return true if an error occurred, the file is in append mode, or `bytes`
+     *         needs more chunks than the engine has distinct long jumps;
+     *         false on success
+     */
+    template <JumpableEngine Engine = Xoshiro256ss>
+    bool writeRandom(io::FileWO& file, uint64_t bytes, RandomFileOptions const& options = {}) noexcept {
+        if (!file.is_open() || file.is_append()) return true;
+        if (bytes == 0) return false;
+
+        const uint64_t seed = detail::randomFileSeed(options);
+        const size_t segment = std::max<size_t>(options.segmentBytes, 1);
+        const double ratio = std::clamp(options.compressibility, 0.0, 1.0);
+        const size_t zero = static_cast<size_t>(ratio * static_cast<double>(segment));
+
+        const uint64_t chunks = (bytes + RandomFileChunkBytes - 1) / RandomFileChunkBytes;
+        // Chunk c uses c long jumps; past the limit the content would repeat from chunk 0
+        if (chunks > detail::longJumpLimit<Engine>()) return true;
+        const unsigned workers = detail::workerCount(options.threads, static_cast<size_t>(std::min<uint64_t>(chunks, SIZE_MAX)));
+        std::atomic<bool> failed{ false };
+
+        detail::runWorkers(workers, [&](unsigned w) noexcept {
+            std::unique_ptr<std::byte[]> buffer{ new (std::nothrow) std::byte[RandomFileChunkBytes] };
+            if (!buffer) {
+                failed.store(true, std::memory_order_relaxed);
+                return;
+            }
+            // Workers take chunks w, w + workers, ... so the writes sweep the file together
+            Engine engine{ seed };
+            for (unsigned i = 0; i < w; ++i) engine.longJump();
+
+            for (uint64_t c = w; c < chunks && !failed.load(std::memory_order_relaxed); c += workers) {
+                const uint64_t offset = c * RandomFileChunkBytes;
+                const size_t size = static_cast<size_t>(std::min<uint64_t>(RandomFileChunkBytes, bytes - offset));
+                Engine block = engine;
+                detail::fillBytes(block, buffer.get(), size);
+                if (zero) detail::zeroSegments(buffer.get(), size, offset, segment, zero);
+                // pwrite leaves the handle's error flags alone; the failure is recorded after joining
+                if (file.pwrite(buffer.get(), size, static_cast<int64_t>(offset))) {
+                    failed.store(true, std::memory_order_relaxed);
+                }
+                for (unsigned i = 0; i < workers; ++i) engine.longJump();
+            }
+            });
+        if (failed.load()) {
+            file.set_write_error();
+            return true;
+        }
+        return false;
+    }
+
+    /**
+     * @brief Create (or truncate) a file and fill it with `bytes` random bytes
+     *
+     * @tparam Engine Jumpable engine type
+     * @param path File path
+     * @param bytes File size
+     * @param options Generation options
+     * @return true if an error occurred, false on success
+     */
+    template <JumpableEngine Engine = Xoshiro256ss>
+    bool writeRandomFile(std::filesystem::path const& path, uint64_t bytes, RandomFileOptions const& options = {}) noexcept {
+        int flags = O_TRUNC;
+#ifdef _MSC_VER
+        flags |= _O_BINARY;
+#endif
+        io::FileWO file;
+        if (!file.create(path, flags)) return true;
+        // Reserve the full size up front so concurrent chunk writes do not extend the file piecemeal
+        if (file.chsize(static_cast<int64_t>(bytes))) return true;
+        return writeRandom<Engine>(file, bytes, options);
+    }
+
+    /**
+     * @brief Create (or truncate) a file holding `records` random records
+     *
+     * The compressibility fraction applies per record: each record starts with
+     * its zero run, unless options.segmentBytes is set to something other than
+     * the default.
+     *
+     * @tparam Engine Jumpable engine type
+     * @param path File path
+     * @param records Number of records
+     * @param recordBytes Size of one record
+     * @param options Generation options
+     * @return true if an error occurred (including a total size overflow), false on success
+     */
+    template <JumpableEngine Engine = Xoshiro256ss>
+    bool writeRandomRecords(std::filesystem::path const& path, uint64_t records, size_t recordBytes,
+        RandomFileOptions options = {}) noexcept {
+        if (recordBytes && records > INT64_MAX / recordBytes) return true;
+        if (options.segmentBytes == RandomFileOptions{}.segmentBytes && recordBytes) {
+            options.segmentBytes = recordBytes;
+        }
+        return writeRandomFile<Engine>(path, records * recordBytes, options);
+    }
+
+} // namespace mz
+
+#endif // MZ_RANDOM_FILE_HEADER_FILE
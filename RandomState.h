@@ -0,0 +1,275 @@
+/*
+MIT License
+
+Copyright (c) 2021-2024 Meysam Zare
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef MZ_RANDOM_STATE_HEADER_FILE
+#define MZ_RANDOM_STATE_HEADER_FILE
+#pragma once
+
+#include <cstdint>
+#include <random>
+#include <span>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "FileIO.h"
+#include "Randomizer.h"
+
+/**
+ * @file RandomState.h
+ * @brief Checkpoint and restore engine state through FileWO / FileRO
+ *
+ * A saved state resumes the exact random stream, so a restarted job does
+ * not have to replay from the seed. The record is written with writeEndian
+ * and reads back on a machine of either byte order:
+ *
+ * | Field   | Type        | Meaning                                        |
+ * |---------|-------------|------------------------------------------------|
+ * | magic   | uint32      | StateMagic                                     |
+ * | version | uint16      | StateFormatVersion                             |
+ * | engine  | uint16      | EngineState<Engine>::Id                        |
+ * | count   | uint32      | Number of state words                          |
+ * | words   | uint64 x n  | Engine state                                   |
+ * | seed    | uint32      | BasicRandomizer::currentSeed(), 0 for engines  |
+ *
+ * std::mt19937 and std::mt19937_64 are stored through their standard text
+ * representation, which is portable across byte orders but not guaranteed
+ * across standard library implementations. ChaCha20Engine deliberately has no
+ * EngineState: writing a CSPRNG key to disk would undo its forward secrecy.
+ *
+ * @author Meysam Zare
+ * @date 2026-10-18
+ */
+
+namespace mz {
+
+    inline constexpr uint32_t StateMagic{ 0x53524D5Au };       ///< "ZMRS" read as little-endian bytes
+    inline constexpr uint16_t StateFormatVersion{ 1 };
+    inline constexpr uint32_t StateMaxWords{ 4096 };            ///< Larger counts are treated as corrupt
+
+    /**
+     * @brief Serialization traits of an engine
+     *
+     * Specializations provide a unique Id, save(engine, words) and
+     * load(engine, words), which returns true on success.
+     */
+    template <typename Engine>
+    struct EngineState;
+
+    template <>
+    struct EngineState<SplitMix64> {
+        static constexpr uint16_t Id{ 1 };
+        static void save(SplitMix64 const& e, std::vector<uint64_t>& words) { words.assign(1, e.state()); }
+        static bool load(SplitMix64& e, std::span<uint64_t const> words) noexcept {
+            if (words.size() != 1) return false;
+            e.setState(words[0]);
+            return true;
+        }
+    };
+
+    template <>
+    struct EngineState<Xoshiro256ss> {
+        static constexpr uint16_t Id{ 2 };
+        static void save(Xoshiro256ss const& e, std::vector<uint64_t>& words) {
+            words.assign(e.state().begin(), e.state().end());
+        }
+        static bool load(Xoshiro256ss& e, std::span<uint64_t const> words) noexcept {
+            if (words.size() != 4) return false;
+            return e.setState({ words[0], words[1], words[2], words[3] });
+        }
+    };
+
+    template <>
+    struct EngineState<Pcg64> {
+        static constexpr uint16_t Id{ 3 };
+        static void save(Pcg64 const& e, std::vector<uint64_t>& words) {
+            const auto s = e.state();
+            words.assign(s.begin(), s.end());
+        }
+        static bool load(Pcg64& e, std::span<uint64_t const> words) noexcept {
+            if (words.size() != 4) return false;
+            return e.setState({ words[0], words[1], words[2], words[3] });
+        }
+    };
+
+    template <>
+    struct EngineState<Wyrand> {
+        static constexpr uint16_t Id{ 4 };
+        static void save(Wyrand const& e, std::vector<uint64_t>& words) { words.assign(1, e.state()); }
+        static bool load(Wyrand& e, std::span<uint64_t const> words) noexcept {
+            if (words.size() != 1) return false;
+            e.setState(words[0]);
+            return true;
+        }
+    };
+
+    namespace detail {
+
+        /**
+         * @brief State words of a standard engine from its text representation
+         */
+        template <typename Engine>
+        struct TextEngineState {
+            static void save(Engine const& e, std::vector<uint64_t>& words) {
+                std::ostringstream os;
+                os << e;
+                std::istringstream is{ os.str() };
+                words.clear();
+                for (uint64_t w; is >> w;) words.push_back(w);
+            }
+            static bool load(Engine& e, std::span<uint64_t const> words) {
+                std::string text;
+                for (uint64_t w : words) {
+                    text += std::to_string(w);
+                    text += ' ';
+                }
+                std::istringstream is{ text };
+                Engine restored;
+                is >> restored;
+                if (is.fail()) return false;
+                e = restored;
+                return true;
+            }
+        };
+
+    } // namespace detail
+
+    template <>
+    struct EngineState<std::mt19937> : detail::TextEngineState<std::mt19937> {
+        static constexpr uint16_t Id{ 16 };
+    };
+
+    template <>
+    struct EngineState<std::mt19937_64> : detail::TextEngineState<std::mt19937_64> {
+        static constexpr uint16_t Id{ 17 };
+    };
+
+    /**
+     * @brief An engine with EngineState traits
+     */
+    template <typename E>
+    concept SerializableEngine = requires { { EngineState<E>::Id } -> std::convertible_to<uint16_t>; };
+
+    namespace detail {
+
+        template <SerializableEngine Engine>
+        bool writeState(io::FileWO& file, Engine const& engine, uint32_t seed) noexcept {
+            std::vector<uint64_t> words;
+            try {
+                EngineState<Engine>::save(engine, words);
+            }
+            catch (...) {
+                return true;
+            }
+            return file.writeEndian(StateMagic)
+                || file.writeEndian(StateFormatVersion)
+                || file.writeEndian(EngineState<Engine>::Id)
+                || file.writeEndian(static_cast<uint32_t>(words.size()))
+                || file.writeEndian(words.data(), words.size())
+                || file.writeEndian(seed);
+        }
+
+        template <SerializableEngine Engine>
+        bool readState(io::FileRO& file, Engine& engine, uint32_t& seed) noexcept {
+            uint32_t magic{ 0 }, count{ 0 };
+            uint16_t version{ 0 }, id{ 0 };
+            if (file.readEndian(magic) || file.readEndian(version) || file.readEndian(id) || file.readEndian(count)) {
+                return true;
+            }
+            if (magic != StateMagic || version != StateFormatVersion || id != EngineState<Engine>::Id || count > StateMaxWords) {
+                return true;
+            }
+            try {
+                std::vector<uint64_t> words(count);
+                if (file.readEndian(words.data(), words.size()) || file.readEndian(seed)) {
+                    return true;
+                }
+                return !EngineState<Engine>::load(engine, words);
+            }
+            catch (...) {
+                return true;
+            }
+        }
+
+    } // namespace detail
+
+    /**
+     * @brief Save an engine's state
+     *
+     * @param file File opened for writing
+     * @param engine Engine to save
+     * @return true if an error occurred, false on success
+     */
+    template <SerializableEngine Engine>
+    bool saveState(io::FileWO& file, Engine const& engine) noexcept {
+        return detail::writeState(file, engine, 0);
+    }
+
+    /**
+     * @brief Restore an engine's state saved by saveState
+     *
+     * The engine is left unchanged if the record is truncated, corrupt or was
+     * written for a different engine type.
+     *
+     * @param file File opened for reading, positioned at the record
+     * @param engine Engine to restore
+     * @return true if an error occurred, false on success
+     */
+    template <SerializableEngine Engine>
+    bool loadState(io::FileRO& file, Engine& engine) noexcept {
+        uint32_t seed{ 0 };
+        return detail::readState(file, engine, seed);
+    }
+
+    /**
+     * @brief Save a randomizer's engine and seed
+     *
+     * @param file File opened for writing
+     * @param rng Randomizer to save
+     * @return true if an error occurred, false on success
+     */
+    template <SerializableEngine Engine>
+    bool saveState(io::FileWO& file, BasicRandomizer<Engine> const& rng) noexcept {
+        return detail::writeState(file, rng.engine(), rng.currentSeed());
+    }
+
+    /**
+     * @brief Restore a randomizer saved by saveState; it continues with the identical stream
+     *
+     * @param file File opened for reading, positioned at the record
+     * @param rng Randomizer to restore (unchanged on error)
+     * @return true if an error occurred, false on success
+     */
+    template <SerializableEngine Engine>
+    bool loadState(io::FileRO& file, BasicRandomizer<Engine>& rng) noexcept {
+        Engine engine{ rng.engine() };
+        uint32_t seed{ 0 };
+        if (detail::readState(file, engine, seed)) return true;
+        rng.restore(engine, seed);
+        return false;
+    }
+
+} // namespace mz
+
+#endif // MZ_RANDOM_STATE_HEADER_FILE
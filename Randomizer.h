@@ -36,18 +36,29 @@ SOFTWARE.
 #include <type_traits>
 #include <algorithm>
 #include <mutex>
+#include <utility>
+#include <cmath>
+#include <concepts>
+
+#include "RandomEngines.h"
+#include "RandomBulk.h"
 
 /**
  * @file Randomizer.h
- * @brief A high-performance wrapper around the Mersenne Twister random number generator
+ * @brief A high-performance wrapper around a pluggable random number engine
  *
  * This header provides a flexible and efficient random number generation utility
  * with support for various integer types, ranges, and special constraints.
  * It leverages C++20 features for improved performance and usability.
  *
+ * The engine is a template parameter. Randomizer keeps the Mersenne Twister for
+ * compatibility; the 64-bit engines from RandomEngines.h (xoshiro256**, PCG64,
+ * wyrand) are much smaller and faster and produce 64-bit values natively, and
+ * SecureRandomizer (ChaCha20Engine.h) is the cryptographically secure option.
+ *
  * For the conversion of 32-bit pseudo-random numbers to 8, 16, 64 bit values,
- * simple bit operations are used for efficiency. More cryptographically secure
- * operations would be recommended for security-critical applications.
+ * simple bit operations are used for efficiency. Only SecureRandomizer is
+ * suitable for security-critical applications.
  *
  * @author Meysam Zare
  * @date 2024-10-14
@@ -55,8 +66,31 @@ SOFTWARE.
 
 namespace mz {
     /**
-     * @class Randomizer
-     * @brief A versatile random number generator based on the Mersenne Twister algorithm
+     * @brief Requirements on an engine usable by BasicRandomizer
+     *
+     * A uniform random bit generator with a full 32-bit or 64-bit output range
+     * that can be reseeded from a 32-bit value.
+     */
+    template <typename E>
+    concept RandomEngine = std::uniform_random_bit_generator<E>
+        && std::default_initializable<E>
+        && requires(E & e, uint32_t s) { e.seed(s); }
+        && E::min() == 0
+        && (E::max() == UINT32_MAX || E::max() == UINT64_MAX);
+
+    /**
+     * @brief Engines that can skip ahead and partition their sequence
+     */
+    template <typename E>
+    concept JumpableEngine = RandomEngine<E> && requires(E & e, size_t n) {
+        e.jump();
+        e.longJump();
+        { e.split(n) } -> std::same_as<std::vector<E>>;
+    };
+
+    /**
+     * @class BasicRandomizer
+     * @brief A versatile random number generator on top of a pluggable engine
      *
      * The Randomizer class provides methods for generating random integers of various
      * sizes (8-bit to 64-bit), with options for signed/unsigned values and specialized
@@ -64,8 +98,11 @@ namespace mz {
      *
      * It also includes utilities for filling arrays and containers with random values,
      * generating random strings, and producing values within specific ranges.
+     *
+     * @tparam Engine Random bit engine; std::mt19937 by default
      */
-    class Randomizer {
+    template <RandomEngine Engine = std::mt19937>
+    class BasicRandomizer {
     public:
         /**
          * @brief Alphanumeric character set used for string generation
@@ -85,11 +122,25 @@ namespace mz {
         static constexpr size_t NumAlphaNumeric{ sizeof(AlphaNumeric) - 1 };
 
         /**
-         * @brief Type definition for the Mersenne Twister engine
+         * @brief Type of the underlying random engine
+         */
+        using engine_type = Engine;
+
+        /**
+         * @brief Whether the engine produces 64 random bits per call
          *
-         * Uses standard MT19937 parameters for high-quality randomness
+         * 64-bit engines serve rand64 with a single call and rand8/16/32 from
+         * the high bits, which are the strongest bits of every supported engine.
          */
-        using engine_type = std::mt19937;
+        static constexpr bool Native64{ engine_type::max() == UINT64_MAX };
+
+        /**
+         * @brief Span size in bytes from which randomize uses the multi-lane bulk generator
+         *
+         * Only applies to Xoshiro256ss; below this size the lane setup (eight
+         * jumps) costs more than it saves.
+         */
+        static constexpr size_t BulkThreshold{ 64 * 1024 };
 
         // ---- Distribution types for optimized generation ----
 
@@ -108,7 +159,7 @@ namespace mz {
 
     private:
         // ---- Core random generation state ----
-        engine_type m_engine;                  ///< Mersenne Twister engine instance
+        engine_type m_engine;                  ///< Random engine instance
         uint32_t m_seed{ 0 };                    ///< Current seed value
         std::random_device m_randomDevice;     ///< Hardware random device for seeding
 
@@ -129,6 +180,14 @@ namespace mz {
          * @param reSeed Whether to reseed from hardware random device
          */
         void updateSeed(uint32_t shift, bool reSeed) noexcept {
+            if constexpr (requires { m_engine.reseed(); }) {
+                // Engines with their own entropy source (ChaCha20Engine) rekey from it
+                // rather than from a 32-bit seed
+                if (reSeed) {
+                    m_engine.reseed();
+                    return;
+                }
+            }
             if (reSeed && m_randomDevice.entropy() > 0.0) {
                 m_seed = m_randomDevice();
             }
@@ -138,23 +197,153 @@ namespace mz {
             m_engine.seed(m_seed);
         }
 
+        /**
+         * @brief Two unbiased indices in [0,a) and [0,b) from one 64-bit output
+         *
+         * Requires a * b < 2^64. The leftover low word of the second product is
+         * checked against the rejection threshold for a * b, which is only
+         * computed when the leftover falls below a * b.
+         */
+        std::pair<size_t, size_t> boundedPair(uint64_t a, uint64_t b) noexcept {
+            const uint64_t product = a * b;
+            uint64_t j, k, rest;
+            auto draw = [&]() noexcept {
+                rest = detail::mul128(rand64(), a, j);
+                rest = detail::mul128(rest, b, k);
+            };
+            draw();
+            if (rest < product) {
+                const uint64_t threshold = (0 - product) % product;
+                while (rest < threshold) draw();
+            }
+            return { static_cast<size_t>(j), static_cast<size_t>(k) };
+        }
+
+        /**
+         * @brief Fill n characters drawn uniformly from an alphabet of m characters
+         *
+         * Each 64-bit value gives four 16-bit lanes, and a lane maps to a
+         * character by multiply-shift (lane * m >> 16). A lane whose low product
+         * falls below 2^16 mod m is rejected, which makes the mapping exact; for
+         * m = 62 that is 4 lanes in 65536. Random words are generated in
+         * batches, by the SIMD bulk generator for long Xoshiro256ss outputs.
+         */
+        template <typename CharT, typename AlphaT>
+        void fillChars(CharT* out, size_t n, AlphaT const* alphabet, size_t m, bool reSeed) noexcept {
+            if (n == 0) return;
+            if (m <= 1) {
+                std::fill_n(out, n, m ? static_cast<CharT>(alphabet[0]) : CharT{});
+                return;
+            }
+            if (m > 0x10000) {
+                for (size_t i = 0; i < n; ++i) {
+                    out[i] = static_cast<CharT>(alphabet[bounded64(m)]);
+                }
+                return;
+            }
+
+            const uint32_t bound = static_cast<uint32_t>(m);
+            const uint32_t threshold = (0x10000u - bound) % bound;
+            constexpr size_t BatchWords = 256;
+            uint64_t words[BatchWords];
+
+            auto generate = [&](auto&& refill) noexcept {
+                size_t i = 0;
+                while (i < n) {
+                    const size_t count = std::min(BatchWords, (n - i) / 4 + 1);
+                    refill(std::span<uint64_t>(words, count));
+                    for (size_t w = 0; w < count && i < n; ++w) {
+                        uint64_t word = words[w];
+                        for (int lane = 0; lane < 4 && i < n; ++lane, word >>= 16) {
+                            const uint32_t x = static_cast<uint32_t>(word & 0xFFFF) * bound;
+                            out[i] = static_cast<CharT>(alphabet[x >> 16]);
+                            i += (x & 0xFFFF) >= threshold;
+                        }
+                    }
+                }
+            };
+
+            if constexpr (std::is_same_v<engine_type, Xoshiro256ss>) {
+                if (!reSeed && n * 2 >= BulkThreshold) {
+                    Xoshiro256ssBulk bulk{ m_engine };
+                    generate([&](std::span<uint64_t> s) noexcept { bulk.fill(s); });
+                    return;
+                }
+            }
+            generate([&](std::span<uint64_t> s) noexcept { randomize(s, reSeed); });
+        }
+
     public:
         /**
          * @brief Default constructor
          *
          * Initializes the random engine with default state
          */
-        Randomizer() noexcept = default;
+        BasicRandomizer() noexcept = default;
 
         /**
          * @brief Constructor with explicit seed
          *
          * @param seed Initial seed value for the random engine
          */
-        explicit Randomizer(uint32_t seed) noexcept : m_seed{ seed } {
+        explicit BasicRandomizer(uint32_t seed) noexcept : m_seed{ seed } {
             m_engine.seed(seed);
         }
 
+        /**
+         * @brief Constructor from a prepared engine, e.g. one stream of a master seed
+         *
+         * @param engine Engine to take over (copied or moved in by the caller)
+         */
+        explicit BasicRandomizer(engine_type engine) noexcept : m_engine{ std::move(engine) } {}
+
+        /**
+         * @brief Access the underlying engine
+         *
+         * @return Reference to the engine
+         */
+        [[nodiscard]] engine_type& engine() noexcept { return m_engine; }
+        [[nodiscard]] engine_type const& engine() const noexcept { return m_engine; }
+
+        /**
+         * @brief The 32-bit seed that reseeding (reSeed = true) builds on
+         */
+        [[nodiscard]] uint32_t currentSeed() const noexcept { return m_seed; }
+
+        /**
+         * @brief Replace the engine and seed, e.g. from a saved checkpoint
+         *
+         * @param engine Engine state to continue from
+         * @param seed Value previously returned by currentSeed()
+         */
+        void restore(engine_type engine, uint32_t seed) noexcept {
+            m_engine = std::move(engine);
+            m_seed = seed;
+        }
+
+        /**
+         * @brief Skip the engine ahead by one jump (2^128 calls for xoshiro256**)
+         */
+        void jump() noexcept requires JumpableEngine<Engine> { m_engine.jump(); }
+
+        /**
+         * @brief Skip the engine ahead by one long jump
+         */
+        void longJump() noexcept requires JumpableEngine<Engine> { m_engine.longJump(); }
+
+        /**
+         * @brief Partition the engine's sequence into n non-overlapping engines
+         *
+         * Pass each to BasicRandomizer(engine_type) to get one randomizer
+         * per worker. This randomizer continues after the last part.
+         *
+         * @param n Number of parts
+         * @return Engines for the parts
+         */
+        [[nodiscard]] std::vector<engine_type> split(size_t n) requires JumpableEngine<Engine> {
+            return m_engine.split(n);
+        }
+
         /**
          * @brief Get a random value from the hardware random device
          *
@@ -216,7 +405,13 @@ namespace mz {
          * @return Random 32-bit unsigned integer
          */
         [[nodiscard]] uint32_t rand32(bool reSeed = false) noexcept {
-            uint32_t result = m_dist32(m_engine);
+            uint32_t result;
+            if constexpr (Native64) {
+                result = static_cast<uint32_t>(m_engine() >> 32);
+            }
+            else {
+                result = m_dist32(m_engine);
+            }
             if (reSeed) {
                 updateSeed(result, reSeed);
             }
@@ -245,6 +440,9 @@ namespace mz {
          * @return Random 8-bit unsigned integer
          */
         [[nodiscard]] uint8_t rand8(bool reSeed = false) noexcept {
+            if constexpr (Native64) {
+                return static_cast<uint8_t>(m_engine() >> 56);
+            }
             return static_cast<uint8_t>(m_dist8(m_engine));
         }
 
@@ -255,18 +453,29 @@ namespace mz {
          * @return Random 16-bit unsigned integer
          */
         [[nodiscard]] uint16_t rand16(bool reSeed = false) noexcept {
+            if constexpr (Native64) {
+                return static_cast<uint16_t>(m_engine() >> 48);
+            }
             return m_dist16(m_engine);
         }
 
         /**
          * @brief Generate a 64-bit unsigned random integer
          *
-         * Combines two 32-bit values for full 64-bit coverage
+         * A single engine call for 64-bit engines; otherwise combines two
+         * 32-bit values for full 64-bit coverage
          *
          * @param reSeed Whether to reseed the generator
          * @return Random 64-bit unsigned integer
          */
         [[nodiscard]] uint64_t rand64(bool reSeed = false) noexcept {
+            if constexpr (Native64) {
+                uint64_t result = m_engine();
+                if (reSeed) {
+                    updateSeed(static_cast<uint32_t>(result), reSeed);
+                }
+                return result;
+            }
             uint64_t high = static_cast<uint64_t>(rand32(reSeed)) << 32;
             uint64_t low = static_cast<uint64_t>(rand32(reSeed));
             return high | low;
@@ -519,7 +728,7 @@ namespace mz {
         /**
          * @brief Function call operator for generating a 32-bit random integer
          *
-         * Allows using the Randomizer object as a function
+         * Allows using the BasicRandomizer object as a function
          *
          * @param reSeed Whether to reseed the generator
          * @return Random 32-bit unsigned integer
@@ -540,11 +749,57 @@ namespace mz {
             t = static_cast<T>(rand32(reSeed));
         }
 
+        // ---- Bounded random number generation ----
+
+        /**
+         * @brief Generate an unbiased 32-bit integer in [0,bound)
+         *
+         * Lemire's nearly-divisionless method: one multiply per value, and the
+         * modulo for the rejection threshold is only computed when the low half
+         * of the product falls below the bound (probability bound / 2^32).
+         *
+         * @param bound Exclusive upper bound; 0 yields 0
+         * @return Random value below the bound
+         */
+        [[nodiscard]] uint32_t bounded32(uint32_t bound) noexcept {
+            uint64_t m = uint64_t{ rand32() } * bound;
+            uint32_t low = static_cast<uint32_t>(m);
+            if (low < bound) {
+                const uint32_t threshold = static_cast<uint32_t>(-bound) % bound;
+                while (low < threshold) {
+                    m = uint64_t{ rand32() } * bound;
+                    low = static_cast<uint32_t>(m);
+                }
+            }
+            return static_cast<uint32_t>(m >> 32);
+        }
+
+        /**
+         * @brief Generate an unbiased 64-bit integer in [0,bound)
+         *
+         * @param bound Exclusive upper bound; 0 yields 0
+         * @return Random value below the bound
+         */
+        [[nodiscard]] uint64_t bounded64(uint64_t bound) noexcept {
+            uint64_t high = 0;
+            uint64_t low = detail::mul128(rand64(), bound, high);
+            if (low < bound) {
+                const uint64_t threshold = (0 - bound) % bound;
+                while (low < threshold) {
+                    low = detail::mul128(rand64(), bound, high);
+                }
+            }
+            return high;
+        }
+
         // ---- Range-based random number generation ----
 
         /**
          * @brief Generate a random integer within a specified range [min,max]
          *
+         * Uses bounded32/bounded64 on the width of the range; the full range of
+         * the type is served directly from the engine.
+         *
          * @tparam T Integral type of the range bounds and result
          * @param min Lower bound (inclusive)
          * @param max Upper bound (inclusive)
@@ -555,11 +810,19 @@ namespace mz {
         [[nodiscard]] T range(T min, T max, bool reSeed = false) noexcept {
             if (min >= max) return min;
 
-            // Create a distribution for this range
-            std::uniform_int_distribution<T> dist(min, max);
+            using U = std::make_unsigned_t<T>;
+            const U width = static_cast<U>(static_cast<U>(max) - static_cast<U>(min));
+            U offset;
+            if constexpr (sizeof(T) <= 4) {
+                offset = width == UINT32_MAX ? static_cast<U>(rand32())
+                    : static_cast<U>(bounded32(static_cast<uint32_t>(width) + 1));
+            }
+            else {
+                offset = width == UINT64_MAX ? static_cast<U>(rand64())
+                    : static_cast<U>(bounded64(static_cast<uint64_t>(width) + 1));
+            }
 
-            // Get a result and possibly reseed
-            T result = dist(m_engine);
+            T result = static_cast<T>(static_cast<U>(static_cast<U>(min) + offset));
             if (reSeed) {
                 updateSeed(static_cast<uint32_t>(result), reSeed);
             }
@@ -567,6 +830,70 @@ namespace mz {
             return result;
         }
 
+        /**
+         * @brief Fill a span with random integers within [min,max]
+         *
+         * The batched form of range(): the rejection threshold is computed once
+         * for the whole span instead of lazily per value.
+         *
+         * @tparam T Integral type of the range bounds and elements
+         * @tparam N Size of the span (deduced)
+         * @param out Span to fill
+         * @param min Lower bound (inclusive)
+         * @param max Upper bound (inclusive)
+         */
+        template <std::integral T, size_t N>
+        void ranges(std::span<T, N> out, T min, T max) noexcept {
+            if (min >= max) {
+                std::fill(out.begin(), out.end(), min);
+                return;
+            }
+
+            using U = std::make_unsigned_t<T>;
+            const U width = static_cast<U>(static_cast<U>(max) - static_cast<U>(min));
+            if constexpr (sizeof(T) <= 4) {
+                if (width == UINT32_MAX) {
+                    for (auto& x : out) x = static_cast<T>(rand32());
+                    return;
+                }
+                const uint32_t bound = static_cast<uint32_t>(width) + 1;
+                const uint32_t threshold = static_cast<uint32_t>(-bound) % bound;
+                for (auto& x : out) {
+                    uint64_t m;
+                    do {
+                        m = uint64_t{ rand32() } * bound;
+                    } while (static_cast<uint32_t>(m) < threshold);
+                    x = static_cast<T>(static_cast<U>(static_cast<U>(min) + static_cast<U>(m >> 32)));
+                }
+            }
+            else {
+                if (width == UINT64_MAX) {
+                    for (auto& x : out) x = static_cast<T>(rand64());
+                    return;
+                }
+                const uint64_t bound = static_cast<uint64_t>(width) + 1;
+                const uint64_t threshold = (0 - bound) % bound;
+                for (auto& x : out) {
+                    uint64_t high = 0;
+                    while (detail::mul128(rand64(), bound, high) < threshold) {}
+                    x = static_cast<T>(static_cast<U>(static_cast<U>(min) + static_cast<U>(high)));
+                }
+            }
+        }
+
+        /**
+         * @brief Fill a vector with random integers within [min,max]
+         *
+         * @tparam T Integral type of the range bounds and elements
+         * @param vec Vector to fill
+         * @param min Lower bound (inclusive)
+         * @param max Upper bound (inclusive)
+         */
+        template <std::integral T>
+        void ranges(std::vector<T>& vec, T min, T max) noexcept {
+            ranges(std::span(vec), min, max);
+        }
+
         /**
          * @brief Generate a floating-point random value within a specified range [min,max]
          *
@@ -609,7 +936,10 @@ namespace mz {
         /**
          * @brief Fill a span with random values
          *
-         * Optimized for different element sizes to maximize performance
+         * Optimized for different element sizes to maximize performance. With the
+         * Xoshiro256ss engine, spans of at least BulkThreshold bytes are written
+         * by Xoshiro256ssBulk (eight SIMD lanes short-jumped off the engine), which
+         * also advances the engine past those lanes.
          *
          * @tparam T Element type (must be integral)
          * @tparam N Size of the span (deduced)
@@ -618,6 +948,21 @@ namespace mz {
          */
         template <std::integral T, size_t N>
         void randomize(std::span<T, N> span, bool reSeed = false) noexcept {
+            if constexpr (std::is_same_v<engine_type, Xoshiro256ss> && !std::is_same_v<T, bool>) {
+                if (!reSeed && span.size_bytes() >= BulkThreshold) {
+                    Xoshiro256ssBulk bulk{ m_engine };
+                    bulk.fill(span);
+                    return;
+                }
+            }
+            else if constexpr (requires(std::span<std::byte> bytes) { m_engine.fill(bytes); } && !std::is_same_v<T, bool>) {
+                // Buffered engines (ChaCha20Engine) copy their output straight into the span
+                if (!reSeed) {
+                    m_engine.fill(std::as_writable_bytes(span));
+                    return;
+                }
+            }
+
             if constexpr (sizeof(T) == 1) {
                 // Optimize for 8-bit values by extracting 4 values from each 32-bit random number
                 uint32_t buffer{ 0 };
@@ -656,6 +1001,18 @@ namespace mz {
                     x = static_cast<T>(rand64(reSeed));
                 }
             }
+            else if constexpr (sizeof(T) == 4 && Native64) {
+                // Two 32-bit values from each 64-bit output
+                size_t i = 0;
+                for (; i + 2 <= span.size(); i += 2) {
+                    uint64_t r = rand64(reSeed);
+                    span[i] = static_cast<T>(r >> 32);
+                    span[i + 1] = static_cast<T>(r);
+                }
+                if (i < span.size()) {
+                    span[i] = static_cast<T>(rand32(reSeed));
+                }
+            }
             else {
                 // Default case for 32-bit and other sizes
                 for (auto& x : span) {
@@ -664,6 +1021,100 @@ namespace mz {
             }
         }
 
+        /**
+         * @brief Fill a span with floating-point values uniform in [0,1)
+         *
+         * Raw engine output is generated in chunks and converted with the
+         * exponent-bit trick (unitDoubles/unitFloats, SIMD where available):
+         * 52 random bits per double and 23 per float, all equally likely.
+         *
+         * @tparam T float or double
+         * @tparam N Size of the span (deduced)
+         * @param span Span to fill
+         */
+        template <std::floating_point T, size_t N>
+            requires (std::is_same_v<T, float> || std::is_same_v<T, double>)
+        void randomize(std::span<T, N> span) noexcept {
+            using bits_type = std::conditional_t<std::is_same_v<T, double>, uint64_t, uint32_t>;
+            constexpr size_t Chunk{ 2048 };
+            bits_type bits[Chunk];
+
+            auto convert = [&](size_t offset, size_t n) noexcept {
+                if constexpr (std::is_same_v<T, double>) {
+                    unitDoubles(bits, span.data() + offset, n);
+                }
+                else {
+                    unitFloats(bits, span.data() + offset, n);
+                }
+            };
+
+            if constexpr (std::is_same_v<engine_type, Xoshiro256ss>) {
+                if (span.size_bytes() >= BulkThreshold) {
+                    Xoshiro256ssBulk bulk{ m_engine };
+                    for (size_t offset = 0; offset < span.size(); offset += Chunk) {
+                        size_t n = std::min(Chunk, span.size() - offset);
+                        bulk.fill(std::span<bits_type>(bits, n));
+                        convert(offset, n);
+                    }
+                    return;
+                }
+            }
+
+            for (size_t offset = 0; offset < span.size(); offset += Chunk) {
+                size_t n = std::min(Chunk, span.size() - offset);
+                randomize(std::span<bits_type>(bits, n));
+                convert(offset, n);
+            }
+        }
+
+        /**
+         * @brief Fill a span with floating-point values uniform in [min,max)
+         *
+         * @tparam T float or double
+         * @tparam N Size of the span (deduced)
+         * @param span Span to fill
+         * @param min Lower bound (inclusive)
+         * @param max Upper bound (exclusive)
+         */
+        template <std::floating_point T, size_t N>
+            requires (std::is_same_v<T, float> || std::is_same_v<T, double>)
+        void randomize(std::span<T, N> span, T min, T max) noexcept {
+            if (!(min < max)) {
+                std::fill(span.begin(), span.end(), min);
+                return;
+            }
+            randomize(span);
+            const T scale = max - min;
+            const T below = std::nextafter(max, min);   // rounding can otherwise land on max
+            for (auto& x : span) {
+                x = std::min(min + x * scale, below);
+            }
+        }
+
+        /**
+         * @brief Fill a vector with floating-point values uniform in [0,1)
+         *
+         * @tparam T float or double
+         * @param vec Vector to fill
+         */
+        template <std::floating_point T>
+        void randomize(std::vector<T>& vec) noexcept {
+            randomize(std::span(vec));
+        }
+
+        /**
+         * @brief Fill a vector with floating-point values uniform in [min,max)
+         *
+         * @tparam T float or double
+         * @param vec Vector to fill
+         * @param min Lower bound (inclusive)
+         * @param max Upper bound (exclusive)
+         */
+        template <std::floating_point T>
+        void randomize(std::vector<T>& vec, T min, T max) noexcept {
+            randomize(std::span(vec), min, max);
+        }
+
         /**
          * @brief Fill a C-style array with random values
          *
@@ -692,7 +1143,10 @@ namespace mz {
         /**
          * @brief Shuffle the elements in a span
          *
-         * Uses Fisher-Yates algorithm for efficient shuffling
+         * Uses Fisher-Yates algorithm for efficient shuffling with Lemire's
+         * bounded generation. With a 64-bit engine, two indices are drawn from
+         * each engine output while i * (i - 1) fits in 64 bits (batched ranged
+         * generation, Brackett-Rozinsky & Lemire).
          *
          * @tparam T Element type
          * @tparam N Size of the span (deduced)
@@ -701,11 +1155,27 @@ namespace mz {
          */
         template <typename T, size_t N>
         void shuffle(std::span<T, N> span, bool reSeed = false) noexcept {
-            if (span.empty()) return;
-
-            for (size_t i = span.size() - 1; i > 0; --i) {
-                size_t j = range32(0, static_cast<uint32_t>(i), reSeed);
-                std::swap(span[i], span[j]);
+            size_t i = span.size();
+            while (i > 1) {
+                if (i > UINT32_MAX) {
+                    size_t j = static_cast<size_t>(bounded64(i));
+                    std::swap(span[i - 1], span[j]);
+                    --i;
+                }
+                else if (Native64 && !reSeed && i > 2) {
+                    auto [j, k] = boundedPair(i, i - 1);
+                    std::swap(span[i - 1], span[j]);
+                    std::swap(span[i - 2], span[k]);
+                    i -= 2;
+                }
+                else {
+                    uint32_t j = bounded32(static_cast<uint32_t>(i));
+                    if (reSeed) {
+                        updateSeed(j, reSeed);
+                    }
+                    std::swap(span[i - 1], span[j]);
+                    --i;
+                }
             }
         }
 
@@ -743,22 +1213,7 @@ namespace mz {
          * @param reSeed Whether to reseed the generator
          */
         void alphanumeric(std::span<char> span, bool reSeed = false) noexcept {
-            uint32_t buffer = rand32(reSeed);
-            unsigned int bits = 32; // Track available bits
-
-            for (auto& ch : span) {
-                // We need ~6 bits per character (64 possible values)
-                // Regenerate when we have fewer than 6 bits left
-                if (bits < 6) {
-                    buffer = rand32(reSeed);
-                    bits = 32;
-                }
-
-                // Use lowest 6 bits for character index
-                ch = AlphaNumeric[buffer & 0x3F]; // 0x3F = 63 (6 bits)
-                buffer >>= 6;
-                bits -= 6;
-            }
+            fillChars(span.data(), span.size(), AlphaNumeric, NumAlphaNumeric, reSeed);
         }
 
         /**
@@ -768,22 +1223,24 @@ namespace mz {
          * @param reSeed Whether to reseed the generator
          */
         void alphanumeric(std::span<wchar_t> span, bool reSeed = false) noexcept {
-            uint32_t buffer = rand32(reSeed);
-            unsigned int bits = 32; // Track available bits
-
-            for (auto& ch : span) {
-                // We need ~6 bits per character (64 possible values)
-                // Regenerate when we have fewer than 6 bits left
-                if (bits < 6) {
-                    buffer = rand32(reSeed);
-                    bits = 32;
-                }
+            fillChars(span.data(), span.size(), AlphaNumeric, NumAlphaNumeric, reSeed);
+        }
 
-                // Use lowest 6 bits for character index
-                ch = static_cast<wchar_t>(AlphaNumeric[buffer & 0x3F]); // 0x3F = 63 (6 bits)
-                buffer >>= 6;
-                bits -= 6;
-            }
+        /**
+         * @brief Fill a span with characters drawn uniformly from an alphabet
+         *
+         * Every character of the alphabet is equally likely (repeat a character
+         * to weight it). An empty alphabet fills the span with CharT{}.
+         *
+         * @tparam CharT Character type
+         * @param span Span to fill
+         * @param alphabet Characters to draw from
+         * @param reSeed Whether to reseed the generator
+         */
+        template <typename CharT>
+        void characters(std::span<CharT> span, std::type_identity_t<std::basic_string_view<CharT>> alphabet,
+            bool reSeed = false) noexcept {
+            fillChars(span.data(), span.size(), alphabet.data(), alphabet.size(), reSeed);
         }
 
         /**
@@ -842,6 +1299,34 @@ namespace mz {
             return result;
         }
 
+        /**
+         * @brief Generate a string of characters drawn uniformly from an alphabet
+         *
+         * @param alphabet Characters to draw from
+         * @param length Length of the string to generate
+         * @param reSeed Whether to reseed the generator
+         * @return Random string
+         */
+        [[nodiscard]] std::string string(std::string_view alphabet, size_t length, bool reSeed = false) noexcept {
+            std::string result(length, '\0');
+            characters(std::span(result), alphabet, reSeed);
+            return result;
+        }
+
+        /**
+         * @brief Generate a wide string of characters drawn uniformly from an alphabet
+         *
+         * @param alphabet Characters to draw from
+         * @param length Length of the string to generate
+         * @param reSeed Whether to reseed the generator
+         * @return Random wide string
+         */
+        [[nodiscard]] std::wstring wstring(std::wstring_view alphabet, size_t length, bool reSeed = false) noexcept {
+            std::wstring result(length, L'\0');
+            characters(std::span(result), alphabet, reSeed);
+            return result;
+        }
+
         /**
          * @brief Fill an existing string with random alphanumeric characters
          *
@@ -874,6 +1359,18 @@ namespace mz {
             return string(length, reSeed);
         }
     };
+
+    /**
+     * @brief The Mersenne Twister randomizer (the original Randomizer)
+     */
+    using Randomizer = BasicRandomizer<std::mt19937>;
+
+    /**
+     * @brief Randomizers on the fast 64-bit engines from RandomEngines.h
+     */
+    using XoshiroRandomizer = BasicRandomizer<Xoshiro256ss>;
+    using Pcg64Randomizer = BasicRandomizer<Pcg64>;
+    using WyRandomizer = BasicRandomizer<Wyrand>;
 }
 
 #endif // MZ_RANDOMIZER_HEADER_FILE
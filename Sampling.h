@@ -0,0 +1,227 @@
+/*
+MIT License
+
+Copyright (c) 2021-2024 Meysam Zare
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef MZ_SAMPLING_HEADER_FILE
+#define MZ_SAMPLING_HEADER_FILE
+#pragma once
+
+#include <cstdint>
+#include <cmath>
+#include <algorithm>
+#include <iterator>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include "RandomDistributions.h"
+
+/**
+ * @file Sampling.h
+ * @brief Uniform sampling without replacement in memory proportional to the sample
+ *
+ * - ReservoirSampler: k items from a stream of unknown length (Li's
+ *   Algorithm L). It draws random numbers only when an item is taken,
+ *   O(k (1 + log(n/k))) in total, and can report how many upcoming items
+ *   will be skipped so the caller can seek past them.
+ * - sampleIndices: k distinct indices from [0,n) by Floyd's algorithm, O(k)
+ *   time and memory regardless of n.
+ *
+ * Both use the randomizer's unbiased bounded generation (bounded64).
+ *
+ * @author Meysam Zare
+ * @date 2026-10-18
+ */
+
+namespace mz {
+
+    /**
+     * @brief A random source with unbiased bounded integers (any BasicRandomizer)
+     */
+    template <typename R>
+    concept BoundedRandomSource = RandomSource64<R> && requires(R & r, uint64_t n) {
+        { r.bounded64(n) } -> std::same_as<uint64_t>;
+    };
+
+    /**
+     * @class ReservoirSampler
+     * @brief Uniform sample of k items from a stream, with geometric skips
+     *
+     * @tparam T Item type
+     */
+    template <typename T>
+    class ReservoirSampler {
+    public:
+        /**
+         * @brief Constructor
+         * @param k Sample size
+         */
+        explicit ReservoirSampler(size_t k) : m_k{ k } {
+            m_sample.reserve(k);
+        }
+
+        /**
+         * @brief Offer the next stream item
+         *
+         * @param rng Random source
+         * @param item Item
+         * @return true if the item was taken into the sample
+         */
+        template <BoundedRandomSource Rng, typename U>
+        bool add(Rng& rng, U&& item) {
+            const uint64_t index = m_seen++;
+            if (m_k == 0) {
+                return false;
+            }
+            if (index < m_k) {
+                m_sample.emplace_back(std::forward<U>(item));
+                if (index + 1 == m_k) {
+                    m_w = std::exp(std::log(detail::unit53Open(rng)) / static_cast<double>(m_k));
+                    advance(rng);
+                }
+                return true;
+            }
+            if (index != m_next) {
+                return false;
+            }
+            m_sample[rng.bounded64(m_k)] = std::forward<U>(item);
+            m_w *= std::exp(std::log(detail::unit53Open(rng)) / static_cast<double>(m_k));
+            advance(rng);
+            return true;
+        }
+
+        /**
+         * @brief Number of upcoming items that add() will not take
+         *
+         * A caller reading from a seekable source can skip them and account for
+         * them with skip().
+         */
+        [[nodiscard]] uint64_t pendingSkip() const noexcept {
+            if (m_k == 0) return UINT64_MAX;
+            return m_seen < m_k ? 0 : m_next - m_seen;
+        }
+
+        /**
+         * @brief Record that n items were consumed without being offered
+         * @param n Number of items skipped; at most pendingSkip()
+         */
+        void skip(uint64_t n) noexcept {
+            m_seen += std::min(n, pendingSkip());
+        }
+
+        /**
+         * @brief The current sample (fewer than k items while the stream is shorter than k)
+         */
+        [[nodiscard]] std::vector<T> const& sample() const noexcept { return m_sample; }
+
+        /**
+         * @brief Move the sample out and reset the sampler
+         */
+        [[nodiscard]] std::vector<T> release() noexcept {
+            std::vector<T> out = std::move(m_sample);
+            m_sample.clear();
+            m_seen = 0;
+            m_next = 0;
+            m_w = 0.0;
+            return out;
+        }
+
+        [[nodiscard]] uint64_t seen() const noexcept { return m_seen; }
+        [[nodiscard]] size_t capacity() const noexcept { return m_k; }
+
+    private:
+        size_t m_k;
+        std::vector<T> m_sample;
+        uint64_t m_seen{ 0 };       ///< Items offered or skipped so far
+        uint64_t m_next{ 0 };       ///< Index of the next item to take
+        double m_w{ 0.0 };
+
+        template <BoundedRandomSource Rng>
+        void advance(Rng& rng) noexcept {
+            const double gap = std::floor(std::log(detail::unit53Open(rng)) / std::log1p(-m_w));
+            const double limit = static_cast<double>(UINT64_MAX - m_seen);
+            m_next = m_seen + (gap < limit ? static_cast<uint64_t>(gap) : UINT64_MAX - m_seen);
+        }
+    };
+
+    /**
+     * @brief Uniform sample of up to k items from an input range
+     *
+     * @param rng Random source
+     * @param first Start of the range
+     * @param last End of the range
+     * @param k Sample size
+     * @return The sample, in no particular order
+     */
+    template <BoundedRandomSource Rng, std::input_iterator It, std::sentinel_for<It> S>
+    [[nodiscard]] std::vector<std::iter_value_t<It>> reservoirSample(Rng& rng, It first, S last, size_t k) {
+        ReservoirSampler<std::iter_value_t<It>> sampler{ k };
+        if constexpr (std::random_access_iterator<It> && std::sized_sentinel_for<S, It>) {
+            while (first != last) {
+                sampler.add(rng, *first);
+                uint64_t skip = std::min<uint64_t>(sampler.pendingSkip(), static_cast<uint64_t>(last - first - 1));
+                first += static_cast<std::iter_difference_t<It>>(skip + 1);
+                sampler.skip(skip);
+            }
+        }
+        else {
+            for (; first != last; ++first) {
+                sampler.add(rng, *first);
+            }
+        }
+        return sampler.release();
+    }
+
+    /**
+     * @brief k distinct indices chosen uniformly from [0,n) (Floyd's algorithm)
+     *
+     * @param rng Random source
+     * @param n Population size
+     * @param k Sample size; all of [0,n) if k >= n
+     * @return The indices in ascending order
+     */
+    template <BoundedRandomSource Rng>
+    [[nodiscard]] std::vector<uint64_t> sampleIndices(Rng& rng, uint64_t n, size_t k) {
+        std::vector<uint64_t> out;
+        if (k >= n) {
+            out.resize(static_cast<size_t>(n));
+            for (uint64_t i = 0; i < n; ++i) out[static_cast<size_t>(i)] = i;
+            return out;
+        }
+
+        std::unordered_set<uint64_t> chosen;
+        chosen.reserve(k * 2);
+        out.reserve(k);
+        for (uint64_t j = n - k; j < n; ++j) {
+            const uint64_t t = rng.bounded64(j + 1);
+            const uint64_t pick = chosen.insert(t).second ? t : j;
+            if (pick == j) chosen.insert(j);
+            out.push_back(pick);
+        }
+        std::sort(out.begin(), out.end());
+        return out;
+    }
+
+} // namespace mz
+
+#endif // MZ_SAMPLING_HEADER_FILE
@@ -0,0 +1,179 @@
+/*
+MIT License
+
+Copyright (c) 2021-2024 Meysam Zare
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef MZ_THREAD_RANDOMIZER_HEADER_FILE
+#define MZ_THREAD_RANDOMIZER_HEADER_FILE
+#pragma once
+
+#include <cstdint>
+#include <atomic>
+#include <random>
+
+#include "Randomizer.h"
+
+/**
+ * @file ThreadRandomizer.h
+ * @brief Per-thread randomizers on independent streams of one master seed
+ *
+ * ThreadRandomizer<Engine>::local() returns a BasicRandomizer owned by the
+ * calling thread, so no call takes a lock. Each thread's engine is stream
+ * `index` of the master seed (see makeStream), so threads never share or
+ * overlap a sequence and a given (seed, index) pair always reproduces the same
+ * numbers.
+ *
+ * Usage:
+ * @code
+ * mz::ThreadRandomizer<>::setMasterSeed(2024);
+ * // in worker i:
+ * mz::ThreadRandomizer<>::bindThread(i);
+ * auto& rng = mz::ThreadRandomizer<>::local();
+ * uint64_t x = rng.rand64();
+ * @endcode
+ *
+ * @author Meysam Zare
+ * @date 2026-10-18
+ */
+
+namespace mz {
+
+    /**
+     * @brief Engine for stream `index` of a master seed
+     *
+     * Uses the engine's own stream() (jump-ahead for xoshiro256**, stream
+     * selector and scrambled start for PCG64, counter offset for wyrand). Standard engines without
+     * one are seeded from a std::seed_seq of both values; their streams are
+     * distinct but not provably non-overlapping.
+     *
+     * @tparam Engine Engine type
+     * @param seed Master seed
+     * @param index Stream index
+     * @return Engine positioned at the start of the stream
+     */
+    template <RandomEngine Engine>
+    [[nodiscard]] Engine makeStream(uint64_t seed, uint64_t index) noexcept {
+        if constexpr (requires { { Engine::stream(seed, index) } -> std::same_as<Engine>; }) {
+            return Engine::stream(seed, index);
+        }
+        else {
+            std::seed_seq seq{
+                static_cast<uint32_t>(seed), static_cast<uint32_t>(seed >> 32),
+                static_cast<uint32_t>(index), static_cast<uint32_t>(index >> 32) };
+            return Engine{ seq };
+        }
+    }
+
+    /**
+     * @class ThreadRandomizer
+     * @brief Static facility handing out one lock-free randomizer per thread
+     *
+     * A thread's index is whatever it passed to bindThread(), or the next free
+     * index in first-use order if it never did. For reproducible runs, bind
+     * every worker explicitly; mixing bound and auto-assigned threads can give
+     * two threads the same index.
+     *
+     * Changing the master seed takes effect in each thread on its next call to
+     * local(), which re-derives the engine for the same index.
+     *
+     * @tparam Engine Random bit engine; Xoshiro256ss by default
+     */
+    template <RandomEngine Engine = Xoshiro256ss>
+    class ThreadRandomizer {
+    public:
+        using randomizer_type = BasicRandomizer<Engine>;
+
+        ThreadRandomizer() = delete;
+
+        /**
+         * @brief Set the master seed for all threads
+         * @param seed Master seed
+         */
+        static void setMasterSeed(uint64_t seed) noexcept {
+            s_masterSeed.store(seed, std::memory_order_relaxed);
+            s_generation.fetch_add(1, std::memory_order_release);
+        }
+
+        /**
+         * @brief Current master seed
+         */
+        [[nodiscard]] static uint64_t masterSeed() noexcept {
+            return s_masterSeed.load(std::memory_order_relaxed);
+        }
+
+        /**
+         * @brief Bind the calling thread to a stream index and reset its engine to the start of that stream
+         * @param index Stream index, typically the worker number
+         */
+        static void bindThread(uint64_t index) noexcept {
+            ThreadState& st = state();
+            st.index = index;
+            st.rebind();
+        }
+
+        /**
+         * @brief Stream index of the calling thread
+         */
+        [[nodiscard]] static uint64_t threadIndex() noexcept {
+            return state().index;
+        }
+
+        /**
+         * @brief The calling thread's randomizer
+         *
+         * One thread_local lookup and one atomic load; never locks.
+         *
+         * @return Reference valid for the lifetime of the calling thread
+         */
+        [[nodiscard]] static randomizer_type& local() noexcept {
+            ThreadState& st = state();
+            if (st.generation != s_generation.load(std::memory_order_acquire)) [[unlikely]] {
+                st.rebind();
+            }
+            return st.randomizer;
+        }
+
+    private:
+        struct ThreadState {
+            randomizer_type randomizer;
+            uint64_t index{ s_nextIndex.fetch_add(1, std::memory_order_relaxed) };
+            uint64_t generation{ UINT64_MAX };      ///< Forces a bind on first use
+
+            void rebind() noexcept {
+                generation = s_generation.load(std::memory_order_acquire);
+                randomizer.engine() = makeStream<Engine>(s_masterSeed.load(std::memory_order_relaxed), index);
+            }
+        };
+
+        static ThreadState& state() noexcept {
+            thread_local ThreadState st;
+            return st;
+        }
+
+        inline static std::atomic<uint64_t> s_masterSeed{ 5489u };
+        inline static std::atomic<uint64_t> s_generation{ 0 };
+        inline static std::atomic<uint64_t> s_nextIndex{ 0 };
+    };
+
+} // namespace mz
+
+#endif // MZ_THREAD_RANDOMIZER_HEADER_FILE
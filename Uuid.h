@@ -0,0 +1,335 @@
+/*
+MIT License
+
+Copyright (c) 2021-2024 Meysam Zare
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef MZ_UUID_HEADER_FILE
+#define MZ_UUID_HEADER_FILE
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <compare>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+
+#if defined(__SSSE3__) || defined(__AVX2__)
+#include <tmmintrin.h>
+#endif
+
+#include "RandomDistributions.h"
+
+/**
+ * @file Uuid.h
+ * @brief RFC 9562 UUID version 4 (random) and version 7 (time-ordered) ids
+ *
+ * Generation draws whole 64-bit words from a randomizer, in batches for the
+ * span overloads, and formatting writes the 36-character text form into a
+ * caller buffer without allocating. Version 7 ids read the clock once per
+ * call (once per batch for spans) and sort in creation order, which keeps
+ * database indexes append-only.
+ *
+ * @author Meysam Zare
+ * @date 2026-10-18
+ */
+
+namespace mz {
+
+    /**
+     * @struct Uuid
+     * @brief A 128-bit UUID in network (big-endian) byte order
+     *
+     * Byte-wise comparison, so version 7 ids compare in time order.
+     */
+    struct Uuid {
+        std::array<uint8_t, 16> bytes{};
+
+        /**
+         * @brief Length of the text form (8-4-4-4-12 hex digits)
+         */
+        static constexpr size_t TextLength{ 36 };
+
+        [[nodiscard]] constexpr unsigned version() const noexcept { return bytes[6] >> 4; }
+        [[nodiscard]] constexpr bool isNil() const noexcept { return *this == Uuid{}; }
+
+        /**
+         * @brief Creation time of a version 7 id, in Unix milliseconds
+         */
+        [[nodiscard]] constexpr uint64_t unixMillis() const noexcept {
+            uint64_t ms = 0;
+            for (int i = 0; i < 6; ++i) ms = (ms << 8) | bytes[i];
+            return ms;
+        }
+
+        /**
+         * @brief Write the lowercase text form
+         *
+         * @param out Buffer of at least TextLength characters (no terminator is written)
+         * @return Pointer past the last character written
+         */
+        char* toChars(char* out) const noexcept {
+            char hex[32];
+#if defined(__SSSE3__) || defined(__AVX2__)
+            const __m128i digits = _mm_setr_epi8('0', '1', '2', '3', '4', '5', '6', '7',
+                '8', '9', 'a', 'b', 'c', 'd', 'e', 'f');
+            const __m128i mask = _mm_set1_epi8(0x0F);
+            const __m128i v = _mm_loadu_si128(reinterpret_cast<__m128i const*>(bytes.data()));
+            const __m128i hi = _mm_shuffle_epi8(digits, _mm_and_si128(_mm_srli_epi16(v, 4), mask));
+            const __m128i lo = _mm_shuffle_epi8(digits, _mm_and_si128(v, mask));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(hex), _mm_unpacklo_epi8(hi, lo));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(hex + 16), _mm_unpackhi_epi8(hi, lo));
+#else
+            constexpr char digits[] = "0123456789abcdef";
+            for (int i = 0; i < 16; ++i) {
+                hex[2 * i] = digits[bytes[i] >> 4];
+                hex[2 * i + 1] = digits[bytes[i] & 0x0F];
+            }
+#endif
+            std::memcpy(out, hex, 8);
+            out[8] = '-';
+            std::memcpy(out + 9, hex + 8, 4);
+            out[13] = '-';
+            std::memcpy(out + 14, hex + 12, 4);
+            out[18] = '-';
+            std::memcpy(out + 19, hex + 16, 4);
+            out[23] = '-';
+            std::memcpy(out + 24, hex + 20, 12);
+            return out + TextLength;
+        }
+
+        /**
+         * @brief The text form as a string
+         */
+        [[nodiscard]] std::string string() const {
+            std::string s(TextLength, '\0');
+            toChars(s.data());
+            return s;
+        }
+
+        /**
+         * @brief Parse the 36-character text form (either case)
+         *
+         * @param text Text to parse
+         * @return The id, or std::nullopt if the text is malformed
+         */
+        [[nodiscard]] static std::optional<Uuid> parse(std::string_view text) noexcept {
+            if (text.size() != TextLength) return std::nullopt;
+            Uuid id;
+            size_t pos = 0;
+            for (int i = 0; i < 16; ++i) {
+                if (pos == 8 || pos == 13 || pos == 18 || pos == 23) {
+                    if (text[pos++] != '-') return std::nullopt;
+                }
+                const int hi = hexValue(text[pos++]);
+                const int lo = hexValue(text[pos++]);
+                if ((hi | lo) < 0) return std::nullopt;
+                id.bytes[i] = static_cast<uint8_t>((hi << 4) | lo);
+            }
+            return id;
+        }
+
+        friend constexpr bool operator==(Uuid const&, Uuid const&) noexcept = default;
+        friend constexpr auto operator<=>(Uuid const&, Uuid const&) noexcept = default;
+
+    private:
+        static constexpr int hexValue(char c) noexcept {
+            if (c >= '0' && c <= '9') return c - '0';
+            if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+            if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+            return -1;
+        }
+    };
+
+    namespace detail {
+
+        inline void storeBE64(uint8_t* p, uint64_t v) noexcept {
+            for (int i = 7; i >= 0; --i) {
+                p[i] = static_cast<uint8_t>(v);
+                v >>= 8;
+            }
+        }
+
+        /**
+         * @brief Set the version nibble and the RFC variant bits
+         */
+        inline void stampUuid(Uuid& id, unsigned version) noexcept {
+            id.bytes[6] = static_cast<uint8_t>((id.bytes[6] & 0x0F) | (version << 4));
+            id.bytes[8] = static_cast<uint8_t>((id.bytes[8] & 0x3F) | 0x80);
+        }
+
+        /**
+         * @brief Fill words from a randomizer, in one bulk call when it has one
+         */
+        template <RandomSource64 Rng>
+        void randomWords(Rng& rng, std::span<uint64_t> words) noexcept {
+            if constexpr (requires { rng.randomize(words); }) {
+                rng.randomize(words);
+            }
+            else {
+                for (auto& w : words) w = rng.rand64();
+            }
+        }
+
+    } // namespace detail
+
+    /**
+     * @brief A random (version 4) UUID
+     *
+     * @param rng Random source; use SecureRandomizer when ids must be unguessable
+     */
+    template <RandomSource64 Rng>
+    [[nodiscard]] Uuid uuid4(Rng& rng) noexcept {
+        Uuid id;
+        detail::storeBE64(id.bytes.data(), rng.rand64());
+        detail::storeBE64(id.bytes.data() + 8, rng.rand64());
+        detail::stampUuid(id, 4);
+        return id;
+    }
+
+    /**
+     * @brief Fill a span with random (version 4) UUIDs
+     *
+     * @param rng Random source
+     * @param out Destination
+     */
+    template <RandomSource64 Rng>
+    void uuid4(Rng& rng, std::span<Uuid> out) noexcept {
+        constexpr size_t Batch = 64;
+        uint64_t words[2 * Batch];
+        for (size_t i = 0; i < out.size(); i += Batch) {
+            const size_t count = std::min(Batch, out.size() - i);
+            detail::randomWords(rng, std::span<uint64_t>(words, 2 * count));
+            for (size_t k = 0; k < count; ++k) {
+                std::memcpy(out[i + k].bytes.data(), words + 2 * k, 16);
+                detail::stampUuid(out[i + k], 4);
+            }
+        }
+    }
+
+    /**
+     * @class UuidV7Generator
+     * @brief Monotonic time-ordered (version 7) UUIDs
+     *
+     * Layout: 48-bit Unix millisecond timestamp, 12-bit counter (rand_a),
+     * 62 random bits (rand_b). The counter starts at a random value below
+     * 2048 in each new millisecond and increments for each further id in the
+     * same millisecond (RFC 9562 method 1); when it overflows the timestamp
+     * is advanced by one, so ids from one generator strictly increase even
+     * if the clock steps back.
+     *
+     * Not thread-safe; keep one generator per thread (for example next to a
+     * ThreadRandomizer). Ids from different generators are ordered only by
+     * their millisecond.
+     */
+    class UuidV7Generator {
+    public:
+        /**
+         * @brief Generate one id
+         *
+         * Reads the clock on every call: nothing cheaper tells when the
+         * millisecond has changed, and a cached value would stamp stale times
+         * after an idle period and break ordering against other generators.
+         * Use fill() to read it once for a whole batch.
+         *
+         * @param rng Random source
+         */
+        template <RandomSource64 Rng>
+        [[nodiscard]] Uuid operator()(Rng& rng) noexcept {
+            const uint64_t bits = rng.rand64();
+            tick(nowMillis(), bits);
+            return make(rng.rand64());
+        }
+
+        /**
+         * @brief Fill a span with increasing ids, reading the clock once
+         *
+         * @param rng Random source
+         * @param out Destination
+         */
+        template <RandomSource64 Rng>
+        void fill(Rng& rng, std::span<Uuid> out) noexcept {
+            if (out.empty()) return;
+            constexpr size_t Batch = 128;
+            uint64_t words[Batch];
+            tick(nowMillis(), rng.rand64());
+            for (size_t i = 0; i < out.size(); i += Batch) {
+                const size_t count = std::min(Batch, out.size() - i);
+                detail::randomWords(rng, std::span<uint64_t>(words, count));
+                for (size_t k = 0; k < count; ++k) {
+                    if (i + k) next();
+                    out[i + k] = make(words[k]);
+                }
+            }
+        }
+
+        /**
+         * @brief Current Unix time in milliseconds
+         */
+        [[nodiscard]] static uint64_t nowMillis() noexcept {
+            using namespace std::chrono;
+            return static_cast<uint64_t>(duration_cast<milliseconds>(system_clock::now().time_since_epoch()).count());
+        }
+
+    private:
+        uint64_t m_millis{ 0 };     ///< Timestamp of the last id
+        uint32_t m_counter{ 0 };    ///< 12-bit counter of the last id
+
+        /**
+         * @brief Move to the state for the first id of a call
+         */
+        void tick(uint64_t now, uint64_t bits) noexcept {
+            if (now > m_millis) {
+                m_millis = now;
+                m_counter = static_cast<uint32_t>(bits >> 53);     // 11 random bits
+            }
+            else {
+                next();
+            }
+        }
+
+        /**
+         * @brief Step to the next id in the current millisecond
+         */
+        void next() noexcept {
+            if (++m_counter > 0xFFF) {
+                m_counter = 0;
+                ++m_millis;
+            }
+        }
+
+        [[nodiscard]] Uuid make(uint64_t random) const noexcept {
+            Uuid id;
+            detail::storeBE64(id.bytes.data(), (m_millis << 16) | (0x7000u | m_counter));
+            detail::storeBE64(id.bytes.data() + 8, random);
+            id.bytes[8] = static_cast<uint8_t>((id.bytes[8] & 0x3F) | 0x80);
+            return id;
+        }
+    };
+
+} // namespace mz
+
+#endif // MZ_UUID_HEADER_FILE
@@ -0,0 +1,204 @@
+/*
+MIT License
+
+Copyright (c) 2021-2024 Meysam Zare
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef MZ_WEIGHTED_SAMPLER_HEADER_FILE
+#define MZ_WEIGHTED_SAMPLER_HEADER_FILE
+#pragma once
+
+#include <cstdint>
+#include <cmath>
+#include <algorithm>
+#include <initializer_list>
+#include <span>
+#include <type_traits>
+#include <vector>
+
+#include "RandomDistributions.h"
+
+/**
+ * @file WeightedSampler.h
+ * @brief Constant-time weighted index sampling with Vose's alias method
+ *
+ * Building the table is O(n); each draw then costs one 64-bit random value,
+ * one multiply and one table lookup, independent of the number of weights.
+ *
+ * @author Meysam Zare
+ * @date 2026-10-18
+ */
+
+namespace mz {
+
+    /**
+     * @class WeightedSampler
+     * @brief Draws index i with probability weights[i] / sum(weights)
+     *
+     * A draw multiplies one 64-bit value by n: the high word picks the column
+     * and the low word is the uniform fraction compared against the column's
+     * threshold, so no second random value or division is needed. The
+     * resulting probabilities are exact to within n / 2^64.
+     */
+    class WeightedSampler {
+    public:
+        WeightedSampler() noexcept = default;
+
+        /**
+         * @brief Constructor from a weight vector; see build()
+         */
+        template <typename W>
+            requires std::is_arithmetic_v<W>
+        explicit WeightedSampler(std::span<W const> weights) noexcept {
+            build(weights);
+        }
+
+        template <typename W>
+            requires std::is_arithmetic_v<W>
+        explicit WeightedSampler(std::vector<W> const& weights) noexcept {
+            build(std::span<W const>(weights));
+        }
+
+        WeightedSampler(std::initializer_list<double> weights) noexcept {
+            build(std::span<double const>(weights.begin(), weights.size()));
+        }
+
+        /**
+         * @brief Build the alias table
+         *
+         * @param weights Non-negative weights with a positive, finite sum
+         * @return true on success; false (leaving the sampler empty) for an
+         *         empty or invalid weight vector or if allocation fails
+         */
+        template <typename W>
+            requires std::is_arithmetic_v<W>
+        bool build(std::span<W const> weights) noexcept {
+            m_table.clear();
+            const size_t n = weights.size();
+            if (n == 0) return false;
+
+            double sum = 0.0;
+            for (W w : weights) {
+                const double d = static_cast<double>(w);
+                if (!(d >= 0.0) || !std::isfinite(d)) return false;
+                sum += d;
+            }
+            if (!(sum > 0.0) || !std::isfinite(sum)) return false;
+
+            try {
+                std::vector<double> scaled(n);
+                std::vector<size_t> small, large;
+                small.reserve(n);
+                large.reserve(n);
+                m_table.resize(n);
+
+                const double factor = static_cast<double>(n) / sum;
+                for (size_t i = 0; i < n; ++i) {
+                    scaled[i] = static_cast<double>(weights[i]) * factor;
+                    (scaled[i] < 1.0 ? small : large).push_back(i);
+                }
+
+                while (!small.empty() && !large.empty()) {
+                    const size_t s = small.back();
+                    small.pop_back();
+                    const size_t l = large.back();
+
+                    m_table[s] = { toThreshold(scaled[s]), l };
+                    scaled[l] = (scaled[l] + scaled[s]) - 1.0;
+                    if (scaled[l] < 1.0) {
+                        large.pop_back();
+                        small.push_back(l);
+                    }
+                }
+                // Whatever is left is 1 up to rounding: the column is its own alias
+                for (size_t i : large) m_table[i] = { UINT64_MAX, i };
+                for (size_t i : small) m_table[i] = { UINT64_MAX, i };
+            }
+            catch (...) {
+                m_table.clear();
+                return false;
+            }
+            return true;
+        }
+
+        template <typename W>
+            requires std::is_arithmetic_v<W>
+        bool build(std::vector<W> const& weights) noexcept {
+            return build(std::span<W const>(weights));
+        }
+
+        [[nodiscard]] size_t size() const noexcept { return m_table.size(); }
+        [[nodiscard]] bool empty() const noexcept { return m_table.empty(); }
+
+        /**
+         * @brief Draw one index
+         *
+         * @param rng Random source (any BasicRandomizer)
+         * @return Index in [0, size()); 0 if the sampler is empty
+         */
+        template <RandomSource64 Rng>
+        [[nodiscard]] size_t operator()(Rng& rng) const noexcept {
+            if (m_table.empty()) return 0;
+            uint64_t column = 0;
+            const uint64_t fraction = detail::mul128(rng.rand64(), m_table.size(), column);
+            Entry const& e = m_table[column];
+            return fraction < e.threshold ? static_cast<size_t>(column) : static_cast<size_t>(e.alias);
+        }
+
+        /**
+         * @brief Draw one index per element of a span
+         *
+         * @param rng Random source
+         * @param out Destination
+         */
+        template <RandomSource64 Rng, std::integral T, size_t N>
+        void fill(Rng& rng, std::span<T, N> out) const noexcept {
+            if (m_table.empty()) {
+                std::fill(out.begin(), out.end(), T{ 0 });
+                return;
+            }
+            const uint64_t n = m_table.size();
+            Entry const* table = m_table.data();
+            for (auto& v : out) {
+                uint64_t column = 0;
+                const uint64_t fraction = detail::mul128(rng.rand64(), n, column);
+                v = static_cast<T>(fraction < table[column].threshold ? column : table[column].alias);
+            }
+        }
+
+    private:
+        struct Entry {
+            uint64_t threshold;     ///< Keep the column when the fraction is below this (p * 2^64)
+            uint64_t alias;         ///< Otherwise return this index
+        };
+
+        std::vector<Entry> m_table;
+
+        static uint64_t toThreshold(double p) noexcept {
+            if (p >= 1.0) return UINT64_MAX;
+            if (p <= 0.0) return 0;
+            return static_cast<uint64_t>(std::ldexp(p, 64));
+        }
+    };
+
+} // namespace mz
+
+#endif // MZ_WEIGHTED_SAMPLER_HEADER_FILE
@@ -0,0 +1,268 @@
+/*
+* MIT License
+*
+* Copyright (c) 2025 Meysam Zare
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*/
+
+/**
+ * @file LoggerBenchmark.cpp
+ * @brief Throughput and tail-latency benchmark for Logger
+ *
+ * Measures messages per second and p50/p99/p999 per-call latency for
+ * Logger<true> with 1 to 64 producer threads and for Logger<false> with a
+ * single producer. Each configuration is run for:
+ * - emitted messages (level at or above the threshold)
+ * - filtered messages (level below the threshold, so only the level check runs)
+ * - log() with a preformatted string and logf() with format arguments
+ * - a rotation-heavy setup with a small maximum file size
+ *
+ * Build (from the repository root):
+ *   c++ -std=c++20 -O2 -I. bench/LoggerBenchmark.cpp -o logger_bench -pthread
+ *
+ * Usage:
+ *   logger_bench [--messages N] [--dir PATH] [--max-threads N]
+ *
+ * To compare against another Logger design, build this same file with -I
+ * pointing at a checkout of that revision and run both with equal options.
+ *
+ * @author Meysam Zare
+ * @date October 18, 2026
+ */
+
+#include <algorithm>
+#include <barrier>
+#include <charconv>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include "Logger.h"
+
+namespace {
+
+    using Clock = std::chrono::steady_clock;
+
+    /**
+     * @brief Which Logger entry point a run exercises
+     */
+    enum class Call { Log, Logf };
+
+    /**
+     * @brief One benchmark configuration
+     */
+    struct Scenario {
+        std::string_view name;
+        Call call{ Call::Log };
+        bool filtered{ false };      ///< Log below the threshold so nothing is emitted
+        bool rotating{ false };      ///< Small max file size to force frequent rotation
+    };
+
+    /**
+     * @brief Results of one run
+     */
+    struct Result {
+        double seconds{ 0 };
+        uint64_t messages{ 0 };
+        uint64_t p50{ 0 }, p99{ 0 }, p999{ 0 }, max{ 0 };  ///< Nanoseconds per call
+    };
+
+    struct Options {
+        uint64_t messages{ 200000 };                 ///< Total messages per run, split across threads
+        std::filesystem::path dir{ "logger_bench_out" };
+        unsigned maxThreads{ 64 };
+    };
+
+    /**
+     * @brief Nanosecond percentile of a sorted latency sample
+     */
+    uint64_t percentile(std::vector<uint32_t> const& sorted, double p) noexcept {
+        if (sorted.empty()) return 0;
+        size_t index = static_cast<size_t>(p * double(sorted.size() - 1) + 0.5);
+        return sorted[std::min(index, sorted.size() - 1)];
+    }
+
+    /**
+     * @brief Issue one timed Logger call
+     */
+    template <bool ThreadSafe>
+    inline uint32_t timedCall(mz::Logger<ThreadSafe>& logger, Scenario const& sc, unsigned thread, uint64_t i) {
+        const auto level = sc.filtered ? mz::LogLevel::Debug : mz::LogLevel::Info;
+        auto start = Clock::now();
+        if (sc.call == Call::Log) {
+            logger.log(level, "request handled: status=200 bytes=1432 route=/api/v1/items");
+        }
+        else {
+            logger.logf(level, "request handled: thread={} seq={} status={} route={}", thread, i, 200, "/api/v1/items");
+        }
+        auto stop = Clock::now();
+        auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(stop - start).count();
+        return static_cast<uint32_t>(std::min<int64_t>(ns, UINT32_MAX));
+    }
+
+    /**
+     * @brief Prepare a logger for a scenario
+     */
+    template <bool ThreadSafe>
+    bool setup(mz::Logger<ThreadSafe>& logger, Scenario const& sc, std::filesystem::path const& path) {
+        std::error_code ec;
+        std::filesystem::remove(path, ec);
+        if (logger.start(path, std::ios::trunc) != 0) {
+            std::fprintf(stderr, "cannot open %s: %s\n", path.string().c_str(), logger.getErrorMessage().c_str());
+            return false;
+        }
+        logger.setLevel(mz::LogLevel::Info);
+        if (sc.rotating) {
+            logger.setMaxFileSize(64 * 1024);
+            logger.setMaxRotationCount(3);
+            logger.setBufferSize(64);
+        }
+        return true;
+    }
+
+    /**
+     * @brief Run a scenario with the given number of producer threads
+     */
+    template <bool ThreadSafe>
+    Result run(Scenario const& sc, unsigned threads, Options const& opt) {
+        Result result{};
+        mz::Logger<ThreadSafe> logger("bench");
+        if (!setup(logger, sc, opt.dir / "bench.log")) {
+            return result;
+        }
+
+        const uint64_t perThread = std::max<uint64_t>(1, opt.messages / threads);
+        std::vector<std::vector<uint32_t>> samples(threads);
+        std::barrier sync(threads + 1);
+
+        std::vector<std::thread> workers;
+        workers.reserve(threads);
+        for (unsigned t = 0; t < threads; ++t) {
+            workers.emplace_back([&, t]() {
+                auto& lat = samples[t];
+                lat.reserve(perThread);
+                sync.arrive_and_wait();
+                for (uint64_t i = 0; i < perThread; ++i) {
+                    lat.push_back(timedCall(logger, sc, t, i));
+                }
+                sync.arrive_and_wait();
+                });
+        }
+
+        // Take the start time before releasing the producers so it cannot trail them
+        auto start = Clock::now();
+        sync.arrive_and_wait();
+        sync.arrive_and_wait();
+        logger.flush();
+        auto stop = Clock::now();
+        for (auto& w : workers) w.join();
+        logger.close();
+
+        std::vector<uint32_t> all;
+        all.reserve(perThread * threads);
+        for (auto& lat : samples) {
+            all.insert(all.end(), lat.begin(), lat.end());
+        }
+        std::sort(all.begin(), all.end());
+
+        result.seconds = std::chrono::duration<double>(stop - start).count();
+        result.messages = perThread * threads;
+        result.p50 = percentile(all, 0.50);
+        result.p99 = percentile(all, 0.99);
+        result.p999 = percentile(all, 0.999);
+        result.max = all.empty() ? 0 : all.back();
+        return result;
+    }
+
+    void printHeader() {
+        std::printf("%-14s %-10s %7s %14s %9s %9s %9s %10s\n",
+            "logger", "scenario", "threads", "msgs/s", "p50 ns", "p99 ns", "p999 ns", "max ns");
+    }
+
+    void printRow(std::string_view logger, Scenario const& sc, unsigned threads, Result const& r) {
+        double rate = r.seconds > 0 ? double(r.messages) / r.seconds : 0.0;
+        std::printf("%-14.*s %-10.*s %7u %14.0f %9llu %9llu %9llu %10llu\n",
+            int(logger.size()), logger.data(), int(sc.name.size()), sc.name.data(), threads, rate,
+            (unsigned long long)r.p50, (unsigned long long)r.p99,
+            (unsigned long long)r.p999, (unsigned long long)r.max);
+        std::fflush(stdout);
+    }
+
+    bool parseUnsigned(std::string_view text, uint64_t& out) {
+        auto [ptr, ec] = std::from_chars(text.data(), text.data() + text.size(), out);
+        return ec == std::errc{} && ptr == text.data() + text.size();
+    }
+
+    bool parseOptions(int argc, char** argv, Options& opt) {
+        for (int i = 1; i < argc; ++i) {
+            std::string_view arg{ argv[i] };
+            bool hasValue = i + 1 < argc;
+            uint64_t value{ 0 };
+            if (arg == "--messages" && hasValue && parseUnsigned(argv[i + 1], value) && value > 0) {
+                opt.messages = value; ++i;
+            }
+            else if (arg == "--max-threads" && hasValue && parseUnsigned(argv[i + 1], value) && value > 0) {
+                opt.maxThreads = unsigned(std::min<uint64_t>(value, 1024)); ++i;
+            }
+            else if (arg == "--dir" && hasValue) {
+                opt.dir = argv[++i];
+            }
+            else {
+                std::fprintf(stderr, "usage: %s [--messages N] [--dir PATH] [--max-threads N]\n", argv[0]);
+                return false;
+            }
+        }
+        return true;
+    }
+
+} // namespace
+
+int main(int argc, char** argv) {
+    Options opt;
+    if (!parseOptions(argc, argv, opt)) {
+        return 2;
+    }
+    std::error_code ec;
+    std::filesystem::create_directories(opt.dir, ec);
+
+    const Scenario scenarios[]{
+        { "log",       Call::Log,  false, false },
+        { "logf",      Call::Logf, false, false },
+        { "filtered",  Call::Log,  true,  false },
+        { "filteredf", Call::Logf, true,  false },
+        { "rotate",    Call::Log,  false, true  },
+    };
+
+    printHeader();
+    for (auto const& sc : scenarios) {
+        printRow("Logger<false>", sc, 1, run<false>(sc, 1, opt));
+        for (unsigned threads = 1; threads <= opt.maxThreads; threads *= 2) {
+            printRow("Logger<true>", sc, threads, run<true>(sc, threads, opt));
+        }
+    }
+
+    std::filesystem::remove_all(opt.dir, ec);
+    return 0;
+}
@@ -0,0 +1,436 @@
+/*
+* MIT License
+*
+* Copyright (c) 2025 Meysam Zare
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*/
+
+/**
+ * @file RandomizerBench.cpp
+ * @brief Throughput benchmark and statistical smoke tests for BasicRandomizer
+ *
+ * For every engine (mt19937, xoshiro256**, PCG64, wyrand, ChaCha20, Philox):
+ * - per-call cost of the scalar methods, in ns per call
+ * - bulk throughput of randomize, ranges, shuffle and alphanumeric
+ * - rand32ThreadSafe with 1 to --max-threads threads sharing one randomizer
+ * - quality tests with p-values:
+ *   - chi-square of bytes from randomize
+ *   - chi-square of alphanumeric characters (flags any character outside
+ *     the alphabet, as the old 6-bit mask produced)
+ *   - chi-square of range() over a span of 3 * 2^30 values, where a
+ *     modulo mapping is visibly biased
+ *   - Wald-Wolfowitz runs above and below 0.5 of randd()
+ *   - Marsaglia's birthday spacings on the high and the low 32 bits of rand64
+ *   - for xoshiro256**, values shared between bulk randomize output of
+ *     stream 0 and the output of stream 1 (must be none)
+ *
+ * p-values outside [0.001, 0.999] are marked "weak" and outside
+ * [1e-6, 1 - 1e-6] "FAIL". These are smoke tests that catch mapping bugs and
+ * regressions; use --stdout with PractRand or TestU01 for full batteries.
+ *
+ * Build (from the repository root):
+ *   c++ -std=c++20 -O2 -march=native -I. bench/RandomizerBench.cpp -o randomizer_bench -pthread
+ *
+ * Usage:
+ *   randomizer_bench [--quick] [--seed N] [--max-threads N]
+ *   randomizer_bench --stdout ENGINE [--seed N] | RNG_test stdin64
+ *
+ * ENGINE is one of mt19937, xoshiro, pcg64, wyrand, chacha20, philox.
+ *
+ * @author Meysam Zare
+ * @date October 18, 2026
+ */
+
+#include <algorithm>
+#include <barrier>
+#include <charconv>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#ifdef _WIN32
+#include <io.h>
+#include <fcntl.h>
+#endif
+
+#include "Randomizer.h"
+#include "ChaCha20Engine.h"
+#include "CounterRandom.h"
+#include "ThreadRandomizer.h"
+
+namespace {
+
+    using Clock = std::chrono::steady_clock;
+
+    /**
+     * @brief Command-line options
+     */
+    struct Options {
+        bool quick{ false };
+        uint32_t seed{ 12345 };
+        unsigned maxThreads{ 8 };
+        std::string_view stdoutEngine;
+    };
+
+    /**
+     * @brief Keeps benchmark results observable so loops are not optimized away
+     */
+    volatile uint64_t g_sink{ 0 };
+
+    double secondsSince(Clock::time_point start) {
+        return std::chrono::duration<double>(Clock::now() - start).count();
+    }
+
+    // ---- Throughput ----
+
+    template <typename Fn>
+    void perCall(std::string_view engine, std::string_view method, uint64_t calls, Fn&& fn) {
+        uint64_t acc{ 0 };
+        auto start = Clock::now();
+        for (uint64_t i = 0; i < calls; ++i) {
+            acc += static_cast<uint64_t>(fn());
+        }
+        double s = secondsSince(start);
+        g_sink = g_sink + acc;
+        std::printf("%-10.*s %-28.*s %10.2f ns/call\n", int(engine.size()), engine.data(),
+            int(method.size()), method.data(), s * 1e9 / double(calls));
+    }
+
+    template <typename Fn>
+    void bulk(std::string_view engine, std::string_view method, size_t bytes, int reps, Fn&& fn) {
+        auto start = Clock::now();
+        for (int r = 0; r < reps; ++r) fn();
+        double s = secondsSince(start);
+        std::printf("%-10.*s %-28.*s %10.2f GB/s\n", int(engine.size()), engine.data(),
+            int(method.size()), method.data(), double(bytes) * reps / s / 1e9);
+    }
+
+    template <typename Engine>
+    void throughput(std::string_view name, Options const& opt) {
+        mz::BasicRandomizer<Engine> rng{ opt.seed };
+        const uint64_t calls = opt.quick ? 2'000'000 : 20'000'000;
+
+        perCall(name, "rand8", calls, [&] { return rng.rand8(); });
+        perCall(name, "rand32", calls, [&] { return rng.rand32(); });
+        perCall(name, "rand64", calls, [&] { return rng.rand64(); });
+        perCall(name, "randd", calls, [&] { return rng.randd() > 0.5; });
+        perCall(name, "range<int>(0, 999)", calls, [&] { return rng.range(0, 999); });
+        perCall(name, "bounded64(10^12)", calls, [&] { return rng.bounded64(1'000'000'000'000ull); });
+        perCall(name, "rand32ThreadSafe (1 thread)", calls, [&] { return rng.rand32ThreadSafe(); });
+
+        const size_t n = opt.quick ? (size_t{ 1 } << 20) : (size_t{ 1 } << 24);
+        const int reps = opt.quick ? 2 : 4;
+        std::vector<uint8_t> u8(n);
+        std::vector<uint32_t> u32(n / 4);
+        std::vector<uint64_t> u64(n / 8);
+        std::vector<double> f64(n / 8);
+        std::string text(n, '\0');
+
+        bulk(name, "randomize(uint8_t)", n, reps, [&] { rng.randomize(u8); });
+        bulk(name, "randomize(uint32_t)", n, reps, [&] { rng.randomize(u32); });
+        bulk(name, "randomize(uint64_t)", n, reps, [&] { rng.randomize(u64); });
+        bulk(name, "randomize(double)", n, reps, [&] { rng.randomize(std::span(f64)); });
+        bulk(name, "ranges(uint32_t, 0, 999)", n, reps, [&] { rng.ranges(u32, 0u, 999u); });
+        bulk(name, "shuffle(uint32_t)", n, reps, [&] { rng.shuffle(u32); });
+        bulk(name, "alphanumeric", n, reps, [&] { rng.alphanumeric(text); });
+        g_sink = g_sink + u8[1] + u32[1] + u64[1] + uint64_t(f64[1] * 10) + uint64_t(text[1]);
+    }
+
+    template <typename Engine>
+    void contention(std::string_view name, Options const& opt) {
+        const uint64_t perThread = opt.quick ? 200'000 : 2'000'000;
+        for (unsigned threads = 1; threads <= opt.maxThreads; threads *= 2) {
+            mz::BasicRandomizer<Engine> rng{ opt.seed };
+            std::barrier sync{ std::ptrdiff_t(threads) + 1 };
+            std::vector<std::jthread> pool;
+            for (unsigned t = 0; t < threads; ++t) {
+                pool.emplace_back([&] {
+                    sync.arrive_and_wait();
+                    uint64_t acc{ 0 };
+                    for (uint64_t i = 0; i < perThread; ++i) acc += rng.rand32ThreadSafe();
+                    g_sink = g_sink + acc;
+                    sync.arrive_and_wait();
+                    });
+            }
+            sync.arrive_and_wait();
+            auto start = Clock::now();
+            sync.arrive_and_wait();
+            double s = secondsSince(start);
+            std::printf("%-10.*s rand32ThreadSafe x%-10u %10.2f Mcalls/s\n", int(name.size()), name.data(),
+                threads, double(perThread) * threads / s / 1e6);
+        }
+    }
+
+    // ---- Quality ----
+
+    double normalTail(double z) {
+        return 0.5 * std::erfc(z / std::sqrt(2.0));
+    }
+
+    /**
+     * @brief Upper tail of the chi-square distribution (Wilson-Hilferty)
+     */
+    double chiSquareP(double x, double df) {
+        double z = (std::cbrt(x / df) - (1.0 - 2.0 / (9.0 * df))) / std::sqrt(2.0 / (9.0 * df));
+        return normalTail(z);
+    }
+
+    double chiSquare(std::vector<uint64_t> const& counts, std::vector<double> const& expected) {
+        double x{ 0.0 };
+        for (size_t i = 0; i < counts.size(); ++i) {
+            double d = double(counts[i]) - expected[i];
+            x += d * d / expected[i];
+        }
+        return x;
+    }
+
+    void report(std::string_view engine, std::string_view test, double statistic, double p) {
+        std::string_view verdict = (p < 1e-6 || p > 1.0 - 1e-6) ? "FAIL"
+            : (p < 1e-3 || p > 1.0 - 1e-3) ? "weak" : "ok";
+        std::printf("%-10.*s %-28.*s %14.2f %10.4f  %.*s\n", int(engine.size()), engine.data(),
+            int(test.size()), test.data(), statistic, p, int(verdict.size()), verdict.data());
+    }
+
+    template <typename Rng>
+    void byteChiSquare(std::string_view name, Rng& rng, size_t n) {
+        std::vector<uint8_t> data(n);
+        rng.randomize(data);
+        std::vector<uint64_t> counts(256);
+        for (uint8_t b : data) ++counts[b];
+        double x = chiSquare(counts, std::vector<double>(256, double(n) / 256.0));
+        report(name, "chi2 bytes (df 255)", x, chiSquareP(x, 255));
+    }
+
+    template <typename Rng>
+    void alphanumericChiSquare(std::string_view name, Rng& rng, size_t n) {
+        constexpr std::string_view alphabet{ Rng::AlphaNumeric, Rng::NumAlphaNumeric };
+        std::string text(n, '\0');
+        rng.alphanumeric(text);
+        // One extra bin collects characters outside the alphabet
+        std::vector<uint64_t> counts(alphabet.size() + 1);
+        for (char c : text) {
+            size_t pos = alphabet.find(c);
+            ++counts[pos == std::string_view::npos ? alphabet.size() : pos];
+        }
+        if (counts.back()) {
+            report(name, "chi2 alphanumeric (df 61)", double(counts.back()), 0.0);
+            return;
+        }
+        counts.pop_back();
+        double x = chiSquare(counts, std::vector<double>(alphabet.size(), double(n) / double(alphabet.size())));
+        report(name, "chi2 alphanumeric (df 61)", x, chiSquareP(x, double(alphabet.size() - 1)));
+    }
+
+    template <typename Rng>
+    void rangeChiSquare(std::string_view name, Rng& rng, size_t n) {
+        // 3 * 2^30 values: mapping a 32-bit draw by modulo makes the first third twice as likely
+        constexpr uint32_t third{ uint32_t{ 1 } << 30 };
+        std::vector<uint64_t> counts(3);
+        for (size_t i = 0; i < n; ++i) {
+            ++counts[rng.range(uint32_t{ 0 }, 3 * third - 1) / third];
+        }
+        double x = chiSquare(counts, std::vector<double>(3, double(n) / 3.0));
+        report(name, "chi2 range(0, 3*2^30) (df 2)", x, chiSquareP(x, 2));
+    }
+
+    template <typename Rng>
+    void runsTest(std::string_view name, Rng& rng, size_t n) {
+        uint64_t above{ 0 }, runs{ 0 };
+        bool last{ false };
+        for (size_t i = 0; i < n; ++i) {
+            bool high = rng.randd() >= 0.5;
+            above += high;
+            runs += (i == 0 || high != last);
+            last = high;
+        }
+        double n1 = double(above), n2 = double(n - above), total = double(n);
+        double mean = 2.0 * n1 * n2 / total + 1.0;
+        double var = (mean - 1.0) * (mean - 2.0) / (total - 1.0);
+        double z = (double(runs) - mean) / std::sqrt(var);
+        report(name, "runs above/below 0.5 (z)", z, normalTail(z));
+    }
+
+    /**
+     * @brief Birthday spacings: m = 4096 birthdays in 2^32 days, lambda = m^3 / (4 * 2^32) = 4
+     */
+    template <typename Rng>
+    void birthdaySpacings(std::string_view name, Rng& rng, int trials, bool lowBits) {
+        constexpr size_t m{ 4096 };
+        std::vector<uint32_t> days(m), spacings(m);
+        uint64_t duplicates{ 0 };
+        for (int t = 0; t < trials; ++t) {
+            for (auto& d : days) {
+                uint64_t v = rng.rand64();
+                d = lowBits ? uint32_t(v) : uint32_t(v >> 32);
+            }
+            std::sort(days.begin(), days.end());
+            spacings[0] = days[0];
+            for (size_t i = 1; i < m; ++i) spacings[i] = days[i] - days[i - 1];
+            std::sort(spacings.begin(), spacings.end());
+            for (size_t i = 1; i < m; ++i) duplicates += spacings[i] == spacings[i - 1];
+        }
+        // The sum over trials is Poisson(4 * trials)
+        double lambda = 4.0 * trials;
+        double z = (double(duplicates) - lambda) / std::sqrt(lambda);
+        report(name, lowBits ? "birthday spacings, low 32" : "birthday spacings, high 32",
+            double(duplicates), normalTail(z));
+    }
+
+    /**
+     * @brief Count values shared by bulk output of stream 0 and stream 1 of a seed
+     *
+     * The bulk generator takes its lanes from the engine it is given; lanes
+     * that reach into the next stream reproduce that stream's output here.
+     */
+    void streamOverlap(std::string_view name, Options const& opt) {
+        const size_t n = opt.quick ? (size_t{ 1 } << 15) : (size_t{ 1 } << 18);
+        mz::BasicRandomizer<mz::Xoshiro256ss> first, second;
+        first.engine() = mz::makeStream<mz::Xoshiro256ss>(opt.seed, 0);
+        second.engine() = mz::makeStream<mz::Xoshiro256ss>(opt.seed, 1);
+
+        std::vector<uint64_t> bulk(n), other(n);
+        first.randomize(bulk);
+        for (size_t i = 0; i < n / 2; ++i) other[i] = second.engine()();
+        second.randomize(std::span<uint64_t>(other).subspan(n / 2));
+
+        std::sort(bulk.begin(), bulk.end());
+        size_t shared{ 0 };
+        for (uint64_t v : other) shared += std::binary_search(bulk.begin(), bulk.end(), v);
+        // 2^36 pairs of 64-bit values collide with probability about 2^-28
+        std::printf("%-10.*s %-28s %14zu %10s  %s\n", int(name.size()), name.data(),
+            "shared values, stream 0 vs 1", shared, "-", shared ? "FAIL" : "ok");
+    }
+
+    template <typename Engine>
+    void quality(std::string_view name, Options const& opt) {
+        mz::BasicRandomizer<Engine> rng{ opt.seed };
+        const size_t n = opt.quick ? (size_t{ 1 } << 22) : (size_t{ 1 } << 26);
+        byteChiSquare(name, rng, n);
+        alphanumericChiSquare(name, rng, n);
+        rangeChiSquare(name, rng, n / 8);
+        runsTest(name, rng, n / 4);
+        birthdaySpacings(name, rng, opt.quick ? 100 : 1000, false);
+        birthdaySpacings(name, rng, opt.quick ? 100 : 1000, true);
+        if constexpr (std::is_same_v<Engine, mz::Xoshiro256ss>) {
+            streamOverlap(name, opt);
+        }
+    }
+
+    // ---- Raw stream for external batteries ----
+
+    template <typename Engine>
+    int streamToStdout(Options const& opt) {
+#ifdef _WIN32
+        _setmode(_fileno(stdout), _O_BINARY);
+#endif
+        mz::BasicRandomizer<Engine> rng{ opt.seed };
+        std::vector<uint64_t> buffer(8192);
+        for (;;) {
+            rng.randomize(buffer);
+            if (std::fwrite(buffer.data(), sizeof(uint64_t), buffer.size(), stdout) != buffer.size()) {
+                return 0;   // reader closed the pipe
+            }
+        }
+    }
+
+    /**
+     * @brief Run `fn.template operator()<Engine>(name)` for the engine called `name`, or all engines
+     */
+    template <typename Fn>
+    bool forEngines(std::string_view only, Fn&& fn) {
+        bool found{ false };
+        auto one = [&]<typename Engine>(std::string_view name) {
+            if (only.empty() || only == name) {
+                found = true;
+                fn.template operator()<Engine>(name);
+            }
+        };
+        one.template operator()<std::mt19937>("mt19937");
+        one.template operator()<mz::Xoshiro256ss>("xoshiro");
+        one.template operator()<mz::Pcg64>("pcg64");
+        one.template operator()<mz::Wyrand>("wyrand");
+        one.template operator()<mz::ChaCha20Engine>("chacha20");
+        one.template operator()<mz::Philox4x32>("philox");
+        return found;
+    }
+
+    bool parseUnsigned(std::string_view text, uint64_t& out) {
+        auto [ptr, ec] = std::from_chars(text.data(), text.data() + text.size(), out);
+        return ec == std::errc{} && ptr == text.data() + text.size();
+    }
+
+    bool parseOptions(int argc, char** argv, Options& opt) {
+        for (int i = 1; i < argc; ++i) {
+            std::string_view arg{ argv[i] };
+            bool hasValue = i + 1 < argc;
+            uint64_t value{ 0 };
+            if (arg == "--quick") {
+                opt.quick = true;
+            }
+            else if (arg == "--seed" && hasValue && parseUnsigned(argv[i + 1], value)) {
+                opt.seed = uint32_t(value); ++i;
+            }
+            else if (arg == "--max-threads" && hasValue && parseUnsigned(argv[i + 1], value) && value > 0) {
+                opt.maxThreads = unsigned(std::min<uint64_t>(value, 1024)); ++i;
+            }
+            else if (arg == "--stdout" && hasValue) {
+                opt.stdoutEngine = argv[++i];
+            }
+            else {
+                std::fprintf(stderr, "usage: %s [--quick] [--seed N] [--max-threads N]\n"
+                    "       %s --stdout ENGINE [--seed N]\n", argv[0], argv[0]);
+                return false;
+            }
+        }
+        return true;
+    }
+
+} // namespace
+
+int main(int argc, char** argv) {
+    Options opt;
+    if (!parseOptions(argc, argv, opt)) {
+        return 2;
+    }
+
+    if (!opt.stdoutEngine.empty()) {
+        int rc{ 0 };
+        bool found = forEngines(opt.stdoutEngine, [&]<typename Engine>(std::string_view) {
+            rc = streamToStdout<Engine>(opt);
+        });
+        if (!found) {
+            std::fprintf(stderr, "unknown engine: %.*s\n", int(opt.stdoutEngine.size()), opt.stdoutEngine.data());
+            return 2;
+        }
+        return rc;
+    }
+
+    std::printf("%-10s %-28s %21s\n", "engine", "method", "throughput");
+    forEngines({}, [&]<typename Engine>(std::string_view name) { throughput<Engine>(name, opt); });
+    forEngines({}, [&]<typename Engine>(std::string_view name) { contention<Engine>(name, opt); });
+
+    std::printf("\n%-10s %-28s %14s %10s  %s\n", "engine", "test", "statistic", "p", "verdict");
+    forEngines({}, [&]<typename Engine>(std::string_view name) { quality<Engine>(name, opt); });
+    return 0;
+}